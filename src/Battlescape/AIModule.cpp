@@ -31,6 +31,7 @@
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Game.h"
+#include "../Engine/Profiler.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
@@ -125,6 +126,7 @@ YAML::Node AIModule::save() const
  */
 void AIModule::think(BattleAction *action)
 {
+	Profiler::Scope scope("AIModule::think");
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
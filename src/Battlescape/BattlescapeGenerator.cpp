@@ -17,7 +17,6 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
-#include <fstream>
 #include <sstream>
 #include "BattlescapeGenerator.h"
 #include "TileEngine.h"
@@ -41,7 +40,6 @@
 #include "../Savegame/EquipmentLayoutItem.h"
 #include "../Engine/Game.h"
 #include "../Engine/LocalizedText.h"
-#include "../Engine/FileMap.h"
 #include "../Engine/Options.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Exception.h"
@@ -1336,23 +1334,23 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
+	const size_t headerSize = 3, cellSize = 4;
 	std::ostringstream filename;
 	filename << "MAPS/" << mapblock->getName() << ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	std::ifstream mapFile (FileMap::getFilePath(filename.str()).c_str(), std::ios::in| std::ios::binary);
-	if (!mapFile)
+	// Load file, it's read from disk only first time this block is used
+	const std::vector<unsigned char> &mapFile = mapblock->getMapFile();
+	if (mapFile.size() < headerSize)
 	{
-		throw Exception(filename.str() + " not found");
+		throw Exception("Invalid MAP file: " + filename.str());
 	}
+	// like the old stream reading, a partial cell at the end of file is ignored
+	const size_t mapEnd = mapFile.size() - (mapFile.size() - headerSize) % cellSize;
 
-	mapFile.read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = (int)(char)mapFile[0];
+	sizex = (int)(char)mapFile[1];
+	sizez = (int)(char)mapFile[2];
 
 	mapblock->setSizeZ(sizez);
 
@@ -1392,8 +1390,9 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile.read((char*)&value, sizeof(value)))
+	for (size_t offset = headerSize; offset < mapEnd; offset += cellSize)
 	{
+		const unsigned char *value = &mapFile[offset];
 		for (int part = O_FLOOR; part <= O_OBJECT; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -1427,13 +1426,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile.eof())
-	{
-		throw Exception("Invalid MAP file: " + filename.str());
-	}
-
-	mapFile.close();
-
 	if (_generateFuel)
 	{
 		// if one of the mapBlocks has an items array defined, don't deploy fuel algorithmically
@@ -1537,22 +1529,21 @@ void BattlescapeGenerator::addSegmentVertical(MapBlock *mapblock, int x, int y,
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
+	const size_t recordSize = 24;
 	std::ostringstream filename;
 	filename << "ROUTES/" << mapblock->getName() << ".RMP";
 
-	// Load file
-	std::ifstream mapFile (FileMap::getFilePath(filename.str()).c_str(), std::ios::in| std::ios::binary);
-	if (!mapFile)
-	{
-		throw Exception(filename.str() + " not found");
-	}
+	// Load file, it's read from disk only first time this block is used
+	const std::vector<unsigned char> &routeFile = mapblock->getRouteFile();
+	// like the old stream reading, a partial record at the end of file is ignored
+	const size_t routeEnd = routeFile.size() - routeFile.size() % recordSize;
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile.read((char*)&value, sizeof(value)))
+	for (size_t offset = 0; offset < routeEnd; offset += recordSize)
 	{
+		const unsigned char *value = &routeFile[offset];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -1619,13 +1610,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile.eof())
-	{
-		throw Exception("Invalid RMP file: " + filename.str());
-	}
-
-	mapFile.close();
 }
 
 /**
@@ -1819,6 +1803,8 @@ void BattlescapeGenerator::loadWeapons(const std::vector<BattleItem*> &itemList)
  */
 void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 {
+	Uint32 startTime = SDL_GetTicks();
+
 	// set our ambient sound
 	_save->setAmbientSound(_terrain->getAmbience());
 	_save->setAmbientVolume(_terrain->getAmbientVolume());
@@ -2464,6 +2450,8 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 	{
 		RNG::setSeed(seed);
 	}
+
+	Log(LOG_VERBOSE) << "Map " << _terrain->getName() << " " << _mapsize_x << "x" << _mapsize_y << "x" << _mapsize_z << " generated in " << (SDL_GetTicks() - startTime) << " ms";
 }
 
 /**
@@ -35,6 +35,8 @@
 #include "MiniMapState.h"
 #include "BattlescapeGenerator.h"
 #include "BriefingState.h"
+#include "Explosion.h"
+#include "Particle.h"
 #include "../lodepng.h"
 #include "../fmath.h"
 #include "../Engine/Game.h"
@@ -1650,6 +1652,29 @@ inline void BattlescapeState::handle(Action *action)
 							_save->getBattleGame()->handleState();
 						}
 					}
+					// "ctrl-m" - show pooled memory use
+					else if (_save->getDebugMode() && action->getDetails()->key.keysym.sym == SDLK_m && (SDL_GetModState() & KMOD_CTRL) != 0)
+					{
+						std::wostringstream ss;
+						ss << L"Items " << BattleItem::getPool().getLive() << L"/" << BattleItem::getPool().getCapacity() << L" (" << BattleItem::getPool().getAllocations() << L")";
+						ss << L" Particles " << Particle::getPool().getLive() << L"/" << Particle::getPool().getCapacity() << L" (" << Particle::getPool().getAllocations() << L")";
+						ss << L" Explosions " << Explosion::getPool().getLive() << L"/" << Explosion::getPool().getCapacity() << L" (" << Explosion::getPool().getAllocations() << L")";
+						debug(ss.str());
+					}
+					// "ctrl-s" - toggle script profiler, report is written to log
+					else if (action->getDetails()->key.keysym.sym == SDLK_s && (SDL_GetModState() & KMOD_CTRL) != 0)
+					{
+						if (Options::scriptProfiler)
+						{
+							ScriptWorkerBase::logProfile();
+							debug(L"Script profile written to log");
+						}
+						else
+						{
+							debug(L"Script profiler started");
+						}
+						Options::scriptProfiler = !Options::scriptProfiler;
+					}
 					// f11 - voxel map dump
 					else if (action->getDetails()->key.keysym.sym == SDLK_F11)
 					{
@@ -2027,6 +2052,10 @@ void BattlescapeState::finishBattle(bool abort, int inExitArea)
 	{
 		_game->popState();
 	}
+	if (Options::scriptProfiler)
+	{
+		ScriptWorkerBase::logProfile();
+	}
 	_game->getCursor()->setVisible(true);
 	if (_save->getAmbientSound() != -1)
 	{
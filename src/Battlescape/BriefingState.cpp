@@ -19,6 +19,7 @@
 #include "BriefingState.h"
 #include "BattlescapeState.h"
 #include "AliensCrashState.h"
+#include "BattlescapeGenerator.h"
 #include "../Engine/Game.h"
 #include "../Engine/LocalizedText.h"
 #include "../Interface/TextButton.h"
@@ -46,8 +47,10 @@ namespace OpenXcom
  * @param game Pointer to the core game.
  * @param craft Pointer to the craft in the mission.
  * @param base Pointer to the base in the mission.
+ * @param generator Configured generator of the mission map, run once the
+ * briefing is on screen so the player reads it while the map is built (takes ownership).
  */
-BriefingState::BriefingState(Craft *craft, Base *base)
+BriefingState::BriefingState(Craft *craft, Base *base, BattlescapeGenerator *generator) : _generator(generator), _framesUntilGenerate(10)
 {
 	_screen = true;
 	// Create objects
@@ -151,7 +154,7 @@ BriefingState::BriefingState(Craft *craft, Base *base)
  */
 BriefingState::~BriefingState()
 {
-
+	delete _generator;
 }
 
 void BriefingState::init()
@@ -171,12 +174,48 @@ void BriefingState::init()
 	}
 }
 
+/**
+ * Generates the battlescape after the briefing had
+ * a few frames to get drawn.
+ */
+void BriefingState::think()
+{
+	State::think();
+	if (_generator)
+	{
+		// Make sure it gets drawn properly
+		if (_framesUntilGenerate > 0)
+		{
+			_framesUntilGenerate--;
+		}
+		else
+		{
+			generateBattle();
+		}
+	}
+}
+
+/**
+ * Runs the generator given to the briefing and frees it.
+ */
+void BriefingState::generateBattle()
+{
+	if (_generator)
+	{
+		_generator->run();
+		delete _generator;
+		_generator = 0;
+	}
+}
+
 /**
  * Closes the window.
  * @param action Pointer to an action.
  */
 void BriefingState::btnOkClick(Action *)
 {
+	// player was faster than the generator
+	generateBattle();
 	_game->popState();
 	Options::baseXResolution = Options::baseXBattlescape;
 	Options::baseYResolution = Options::baseYBattlescape;
@@ -27,6 +27,7 @@ class Window;
 class Text;
 class Craft;
 class Base;
+class BattlescapeGenerator;
 
 /**
  * Briefing screen which displays info
@@ -39,13 +40,19 @@ private:
 	Window *_window;
 	Text *_txtTitle, *_txtTarget, *_txtCraft, *_txtBriefing;
 	std::string _cutsceneId, _musicId;
+	BattlescapeGenerator *_generator;
+	int _framesUntilGenerate;
+	/// Runs the pending battlescape generator, if any.
+	void generateBattle();
 public:
 	/// Creates the Briefing state.
-	BriefingState(Craft *craft = 0, Base *base = 0);
+	BriefingState(Craft *craft = 0, Base *base = 0, BattlescapeGenerator *generator = 0);
 	/// Cleans up the Briefing state.
 	~BriefingState();
 	/// Initialization
 	void init();
+	/// Generates the battlescape once the briefing is shown.
+	void think();
 	/// Handler for clicking the Ok button.
 	void btnOkClick(Action *action);
 };
@@ -44,6 +44,36 @@ Explosion::~Explosion()
 
 }
 
+/**
+ * Allocates memory for new explosion from shared pool.
+ * @param size Size of object.
+ * @return Pointer to memory.
+ */
+void *Explosion::operator new(size_t size)
+{
+	return getPool().allocate(size);
+}
+
+/**
+ * Returns memory of deleted explosion to shared pool.
+ * @param p Pointer to memory.
+ * @param size Size of object.
+ */
+void Explosion::operator delete(void *p, size_t size)
+{
+	getPool().deallocate(p, size);
+}
+
+/**
+ * Gets shared pool of explosions, created on first use.
+ * @return Pool.
+ */
+ObjectPool<Explosion> &Explosion::getPool()
+{
+	static ObjectPool<Explosion> pool;
+	return pool;
+}
+
 /**
  * Animates the explosion further.
  * @return false If the animation is finished.
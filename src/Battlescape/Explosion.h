@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Position.h"
+#include "../Engine/ObjectPool.h"
 
 namespace OpenXcom
 {
@@ -40,6 +41,12 @@ public:
 	Explosion(Position _position, int startFrame, int frameDelay = 0, bool big = false, bool hit = false);
 	/// Cleans up the Explosion.
 	~Explosion();
+	/// Allocates memory from shared pool of explosions.
+	static void *operator new(size_t size);
+	/// Returns memory to shared pool of explosions.
+	static void operator delete(void *p, size_t size);
+	/// Gets shared pool of explosions.
+	static ObjectPool<Explosion> &getPool();
 	/// Moves the Explosion on one frame.
 	bool animate();
 	/// Gets the current position in voxel space.
@@ -35,6 +35,7 @@
 #include "../Engine/Palette.h"
 #include "../Engine/Game.h"
 #include "../Engine/Screen.h"
+#include "../Engine/Profiler.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Savegame/BattleUnit.h"
@@ -67,6 +68,46 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Division rounding toward negative infinity.
+ */
+int floorDiv(int a, int b)
+{
+	return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+/**
+ * Narrows range of indexes to ones that could have `start + i * step` strictly between `low` and `high`.
+ * Result can be bigger than exact range but never smaller.
+ * @param begin First index of range.
+ * @param end Last index of range.
+ */
+void limitLinearRange(int &begin, int &end, int start, int step, int low, int high)
+{
+	if (step == 0)
+	{
+		if (start <= low || start >= high)
+		{
+			end = begin - 1;
+		}
+	}
+	else if (step > 0)
+	{
+		begin = std::max(begin, floorDiv(low - start, step));
+		end = std::min(end, floorDiv(high - start, step));
+	}
+	else
+	{
+		begin = std::max(begin, floorDiv(start - high, -step));
+		end = std::min(end, floorDiv(start - low, -step));
+	}
+}
+
+} // namespace
+
 /**
  * Sets up a map with the specified size and position.
  * @param game Pointer to the core game.
@@ -113,6 +154,8 @@ Map::Map(Game *game, int width, int height, int x, int y, int visibleMapHeight)
 	_txtAccuracy->setPalette(_game->getScreen()->getPalette());
 	_txtAccuracy->setHighContrast(true);
 	_txtAccuracy->initText(_game->getMod()->getFont("FONT_BIG"), _game->getMod()->getFont("FONT_SMALL"), _game->getLanguage());
+
+	_unitSpriteCache = new UnitSpriteCache();
 }
 
 /**
@@ -126,6 +169,8 @@ Map::~Map()
 	delete _message;
 	delete _camera;
 	delete _txtAccuracy;
+	delete _unitSpriteCache;
+	Explosion::getPool().trim();
 }
 
 /**
@@ -154,6 +199,12 @@ void Map::init()
 			_arrow->setPixel(x, y, pixels[x+(y*9)]);
 	_arrow->unlock();
 
+	_cursorSet = _game->getMod()->getSurfaceSet("CURSOR.PCK");
+	_smokeSet = _game->getMod()->getSurfaceSet("SMOKE.PCK");
+	_pathfindingSet = _game->getMod()->getSurfaceSet("Pathfinding");
+	_explosionSet = _game->getMod()->getSurfaceSet("X1.PCK");
+	_hitSet = _game->getMod()->getSurfaceSet("HIT.PCK");
+
 	_projectile = 0;
 	if (_save->getDepth() == 0)
 	{
@@ -485,6 +536,7 @@ void Map::drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Posit
  */
 void Map::drawTerrain(Surface *surface)
 {
+	Profiler::Scope scope("Map::drawTerrain");
 	int frameNumber = 0;
 	Surface *tmpSurface;
 	Tile *tile;
@@ -496,7 +548,7 @@ void Map::drawTerrain(Surface *surface)
 	int dummy;
 	BattleUnit *unit = 0;
 	int tileShade, wallShade, tileColor;
-	UnitSprite unitSprite(surface, _game->getMod(), _animFrame, _save->getDepth() != 0);
+	UnitSprite unitSprite(surface, _game->getMod(), _animFrame, _save->getDepth() != 0, _unitSpriteCache);
 	ItemSprite itemSprite(surface, _game->getMod(), _animFrame);
 
 	const int halfAnimFrame = (_animFrame / 2) % 4;
@@ -617,6 +669,9 @@ void Map::drawTerrain(Surface *surface)
 		beginX = 0;
 	if (beginY < 0)
 		beginY = 0;
+	// cells outside of the map have nothing to draw.
+	endX = std::min(endX, _save->getMapSizeX() - 1);
+	endY = std::min(endY, _save->getMapSizeY() - 1);
 
 	bool pathfinderTurnedOn = _save->getPathfinding()->isPathPreviewed();
 
@@ -633,7 +688,17 @@ void Map::drawTerrain(Surface *surface)
 		bool topLayer = itZ == endZ;
 		for (int itX = beginX; itX <= endX; itX++)
 		{
-			for (int itY = beginY; itY <= endY; itY++)
+			// screen position is linear in itY, skip cells that can't be inside the surface.
+			Position rowStart, rowStep;
+			_camera->convertMapToScreen(Position(itX, 0, itZ), &rowStart);
+			_camera->convertMapToScreen(Position(itX, 1, itZ), &rowStep);
+			rowStep -= rowStart;
+			rowStart += _camera->getMapOffset();
+			int rowBeginY = beginY, rowEndY = endY;
+			limitLinearRange(rowBeginY, rowEndY, rowStart.x, rowStep.x, -_spriteWidth, surface->getWidth() + _spriteWidth);
+			limitLinearRange(rowBeginY, rowEndY, rowStart.y, rowStep.y, -_spriteHeight, surface->getHeight() + _spriteHeight);
+
+			for (int itY = rowBeginY; itY <= rowEndY; itY++)
 			{
 				mapPosition = Position(itX, itY, itZ);
 				_camera->convertMapToScreen(mapPosition, &screenPosition);
@@ -644,11 +709,12 @@ void Map::drawTerrain(Surface *surface)
 					screenPosition.y > -_spriteHeight && screenPosition.y < surface->getHeight() + _spriteHeight )
 				{
 					tile = _save->getTile(mapPosition);
-					Tile *tileNorth = _save->getTile(mapPosition - Position(0,1,0));
-					Tile *tileWest = _save->getTile(mapPosition - Position(1,0,0));
 
 					if (!tile) continue;
 
+					Tile *tileNorth = _save->getTile(mapPosition - Position(0,1,0));
+					Tile *tileWest = _save->getTile(mapPosition - Position(1,0,0));
+
 					if (tile->isDiscovered(2))
 					{
 						tileShade = tile->getShade();
@@ -685,13 +751,13 @@ void Map::drawTerrain(Surface *surface)
 								else
 									frameNumber = 6; // red static crosshairs
 							}
-							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frameNumber);
+							tmpSurface = _cursorSet->getFrame(frameNumber);
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 						}
 						else if (_camera->getViewLevel() > itZ)
 						{
 							frameNumber = 2; // blue box
-							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frameNumber);
+							tmpSurface = _cursorSet->getFrame(frameNumber);
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 						}
 					}
@@ -887,7 +953,7 @@ void Map::drawTerrain(Surface *surface)
 						{
 							frameNumber += halfAnimFrame + tile->getAnimationOffset();
 						}
-						tmpSurface = _game->getMod()->getSurfaceSet("SMOKE.PCK")->getFrame(frameNumber);
+						tmpSurface = _smokeSet->getFrame(frameNumber);
 						tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, shade);
 					}
 
@@ -918,13 +984,13 @@ void Map::drawTerrain(Surface *surface)
 					{
 						if (itZ > 0 && tile->hasNoFloor(_save->getTile(tile->getPosition() + Position(0,0,-1))))
 						{
-							tmpSurface = _game->getMod()->getSurfaceSet("Pathfinding")->getFrame(11);
+							tmpSurface = _pathfindingSet->getFrame(11);
 							if (tmpSurface)
 							{
 								tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y+2, 0, false, tile->getMarkerColor());
 							}
 						}
-						tmpSurface = _game->getMod()->getSurfaceSet("Pathfinding")->getFrame(tile->getPreview());
+						tmpSurface = _pathfindingSet->getFrame(tile->getPreview());
 						if (tmpSurface)
 						{
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y + tile->getTerrainLevel(), 0, false, tileColor);
@@ -959,7 +1025,7 @@ void Map::drawTerrain(Surface *surface)
 								else
 									frameNumber = 6; // red static crosshairs
 							}
-							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frameNumber);
+							tmpSurface = _cursorSet->getFrame(frameNumber);
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 
 							// UFO extender accuracy: display adjusted accuracy value on crosshair in real-time.
@@ -1037,13 +1103,13 @@ void Map::drawTerrain(Surface *surface)
 						else if (_camera->getViewLevel() > itZ)
 						{
 							frameNumber = 5; // blue box
-							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frameNumber);
+							tmpSurface = _cursorSet->getFrame(frameNumber);
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 						}
 						if (_cursorType > 2 && _camera->getViewLevel() == itZ)
 						{
 							int frame[6] = {0, 0, 0, 11, 13, 15};
-							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frame[_cursorType] + (_animFrame / 4) % 2);
+							tmpSurface = _cursorSet->getFrame(frame[_cursorType] + (_animFrame / 4) % 2);
 							tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 						}
 					}
@@ -1059,7 +1125,7 @@ void Map::drawTerrain(Surface *surface)
 						{
 							if (waypXOff == 2 && waypYOff == 2)
 							{
-								tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(7);
+								tmpSurface = _cursorSet->getFrame(7);
 								tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y, 0);
 							}
 							if (_save->getBattleGame()->getCurrentAction()->type == BA_LAUNCH)
@@ -1111,14 +1177,14 @@ void Map::drawTerrain(Surface *surface)
 						{
 							if (itZ > 0 && tile->hasNoFloor(tileBelow))
 							{
-								tmpSurface = _game->getMod()->getSurfaceSet("Pathfinding")->getFrame(23);
+								tmpSurface = _pathfindingSet->getFrame(23);
 								if (tmpSurface)
 								{
 									tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y+2, 0, false, tile->getMarkerColor());
 								}
 							}
 							int overlay = tile->getPreview() + 12;
-							tmpSurface = _game->getMod()->getSurfaceSet("Pathfinding")->getFrame(overlay);
+							tmpSurface = _pathfindingSet->getFrame(overlay);
 							if (tmpSurface)
 							{
 								tmpSurface->blitNShade(surface, screenPosition.x, screenPosition.y - adjustment, 0, false, tile->getMarkerColor());
@@ -1206,18 +1272,18 @@ void Map::drawTerrain(Surface *surface)
 				{
 					if ((*i)->getCurrentFrame() >= 0)
 					{
-						tmpSurface = _game->getMod()->getSurfaceSet("X1.PCK")->getFrame((*i)->getCurrentFrame());
+						tmpSurface = _explosionSet->getFrame((*i)->getCurrentFrame());
 						tmpSurface->blitNShade(surface, bulletPositionScreen.x - (tmpSurface->getWidth() / 2), bulletPositionScreen.y - (tmpSurface->getHeight() / 2), 0);
 					}
 				}
 				else if ((*i)->isHit())
 				{
-					tmpSurface = _game->getMod()->getSurfaceSet("HIT.PCK")->getFrame((*i)->getCurrentFrame());
+					tmpSurface = _hitSet->getFrame((*i)->getCurrentFrame());
 					tmpSurface->blitNShade(surface, bulletPositionScreen.x - 15, bulletPositionScreen.y - 25, 0);
 				}
 				else
 				{
-					tmpSurface = _game->getMod()->getSurfaceSet("SMOKE.PCK")->getFrame((*i)->getCurrentFrame());
+					tmpSurface = _smokeSet->getFrame((*i)->getCurrentFrame());
 					tmpSurface->blitNShade(surface, bulletPositionScreen.x - 15, bulletPositionScreen.y - 15, 0);
 				}
 			}
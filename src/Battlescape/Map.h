@@ -37,6 +37,7 @@ class Timer;
 class Text;
 class Tile;
 class UnitSprite;
+class UnitSpriteCache;
 
 enum CursorType { CT_NONE, CT_NORMAL, CT_AIM, CT_PSI, CT_WAYPOINT, CT_THROW };
 enum TilePart : int;
@@ -71,6 +72,8 @@ private:
 	PathPreview _previewSetting;
 	Text *_txtAccuracy;
 	SurfaceSet *_projectileSet;
+	SurfaceSet *_cursorSet, *_smokeSet, *_pathfindingSet, *_explosionSet, *_hitSet;
+	UnitSpriteCache *_unitSpriteCache;
 
 	void drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Position tileScreenPosition, int shade, bool topLayer);
 	void drawTerrain(Surface *surface);
@@ -55,6 +55,36 @@ Particle::~Particle()
 {
 }
 
+/**
+ * Allocates memory for new particle from shared pool.
+ * @param size Size of object.
+ * @return Pointer to memory.
+ */
+void *Particle::operator new(size_t size)
+{
+	return getPool().allocate(size);
+}
+
+/**
+ * Returns memory of deleted particle to shared pool.
+ * @param p Pointer to memory.
+ * @param size Size of object.
+ */
+void Particle::operator delete(void *p, size_t size)
+{
+	getPool().deallocate(p, size);
+}
+
+/**
+ * Gets shared pool of particles, created on first use.
+ * @return Pool.
+ */
+ObjectPool<Particle> &Particle::getPool()
+{
+	static ObjectPool<Particle> pool;
+	return pool;
+}
+
 /**
  * Animates the particle.
  * @return if we are done animating this particle yet.
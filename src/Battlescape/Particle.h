@@ -19,6 +19,7 @@
  */
 #include <SDL_types.h>
 #include <algorithm>
+#include "../Engine/ObjectPool.h"
 
 namespace OpenXcom
 {
@@ -33,6 +34,12 @@ public:
 	Particle(float xOffset, float yOffset, float density, Uint8 color, Uint8 opacity);
 	/// Destroy a particle.
 	~Particle();
+	/// Allocates memory from shared pool of particles.
+	static void *operator new(size_t size);
+	/// Returns memory to shared pool of particles.
+	static void operator delete(void *p, size_t size);
+	/// Gets shared pool of particles.
+	static ObjectPool<Particle> &getPool();
 	/// Animate a particle.
 	bool animate();
 	/// Get the size value.
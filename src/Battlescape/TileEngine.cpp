@@ -21,6 +21,7 @@
 #include <set>
 #include "TileEngine.h"
 #include <SDL.h>
+#include <SDL_thread.h>
 #include "AIModule.h"
 #include "Map.h"
 #include "Camera.h"
@@ -42,6 +43,7 @@
 #include "Pathfinding.h"
 #include "../Engine/Game.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
 #include "../fmath.h"
@@ -57,9 +59,10 @@ namespace
  * @param target Target.
  * @param posFunc Function call for each step in primary direction of line.
  * @param driftFunc Function call for each side step of line.
+ * @param skipFunc Function call that can report a box of voxels (inclusive bounds) around given position that need no checks.
  */
-template<typename FuncNewPosition, typename FuncDrift>
-bool calculateLineHitHelper(const Position& origin, const Position& target, FuncNewPosition posFunc, FuncDrift driftFunc)
+template<typename FuncNewPosition, typename FuncDrift, typename FuncSkip>
+bool calculateLineHitHelper(const Position& origin, const Position& target, FuncNewPosition posFunc, FuncDrift driftFunc, FuncSkip skipFunc)
 {
 	int x, x0, x1, delta_x, step_x;
 	int y, y0, y1, delta_y, step_y;
@@ -124,6 +127,46 @@ bool calculateLineHitHelper(const Position& origin, const Position& target, Func
 
 		if (x == x1) break;
 
+		//whole box around current position can be crossed without checks
+		Position low, high;
+		if (skipFunc(Position(cx, cy, cz), low, high))
+		{
+			int lx = low.x, ly = low.y, lz = low.z;
+			int hx = high.x, hy = high.y, hz = high.z;
+			if (swap_xy) { std::swap(lx, ly); std::swap(hx, hy); }
+			if (swap_xz) { std::swap(lx, lz); std::swap(hx, hz); }
+
+			//number of steps that stay inside box, after `k` steps `y` moved by smallest `n` that keep `drift_xy - k * delta_y + n * delta_x >= 0`
+			int k = std::min(step_x > 0 ? hx - x : x - lx, abs(x1 - x));
+			if (delta_y > 0)
+			{
+				k = std::min(k, (drift_xy + (step_y > 0 ? hy - y : y - ly) * delta_x) / delta_y);
+			}
+			if (delta_z > 0)
+			{
+				k = std::min(k, (drift_xz + (step_z > 0 ? hz - z : z - lz) * delta_x) / delta_z);
+			}
+
+			//jump all but last step, last one is done normally below
+			if (k > 1)
+			{
+				const int jump = k - 1;
+				int n;
+
+				drift_xy = drift_xy - jump * delta_y;
+				n = drift_xy < 0 ? (delta_x - 1 - drift_xy) / delta_x : 0;
+				drift_xy = drift_xy + n * delta_x;
+				y = y + n * step_y;
+
+				drift_xz = drift_xz - jump * delta_z;
+				n = drift_xz < 0 ? (delta_x - 1 - drift_xz) / delta_x : 0;
+				drift_xz = drift_xz + n * delta_x;
+				z = z + n * step_z;
+
+				x = x + jump * step_x;
+			}
+		}
+
 		//update progress in other planes
 		drift_xy = drift_xy - delta_y;
 		drift_xz = drift_xz - delta_z;
@@ -161,6 +204,19 @@ bool calculateLineHitHelper(const Position& origin, const Position& target, Func
 	return false;
 }
 
+/**
+ * Calculates a line trajectory, using bresenham algorithm in 3D, checking every voxel.
+ * @param origin Origin.
+ * @param target Target.
+ * @param posFunc Function call for each step in primary direction of line.
+ * @param driftFunc Function call for each side step of line.
+ */
+template<typename FuncNewPosition, typename FuncDrift>
+bool calculateLineHitHelper(const Position& origin, const Position& target, FuncNewPosition posFunc, FuncDrift driftFunc)
+{
+	return calculateLineHitHelper(origin, target, posFunc, driftFunc, [](Position, Position&, Position&) { return false; });
+}
+
 /**
  * Iterate through some subset of map tiles.
  * @param save Map data.
@@ -208,6 +264,79 @@ GraphSubset mapAreaExpand(GraphSubset gs, int radius)
 	return { std::make_pair(gs.beg_x - radius, gs.end_x + radius), std::make_pair(gs.beg_y - radius, gs.end_y + radius) };
 }
 
+/**
+ * Check if tile have nothing that could block voxel line, no terrain and no units.
+ * @param tile Tile to check.
+ * @param tileBelow Tile below, its unit can stick up to this tile.
+ * @return True if all voxels of tile are empty.
+ */
+bool isTileVoxelEmpty(const Tile* tile, const Tile* tileBelow)
+{
+	return tile->isVoid() && tile->getUnit() == 0 && (!tileBelow || tileBelow->getUnit() == 0);
+}
+
+/**
+ * Precomputed directions of rays used by explosions.
+ */
+struct ExplosionRays
+{
+	static constexpr int teStep = 3;
+	static constexpr int teSize = 360 / teStep + 1;
+	static constexpr int fiStep = 5;
+	static constexpr int fiSize = 180 / fiStep + 1;
+
+	double sin_te[teSize], cos_te[teSize];
+	double sin_fi[fiSize], cos_fi[fiSize];
+
+	ExplosionRays()
+	{
+		for (int i = 0; i < teSize; ++i)
+		{
+			const int te = i * teStep;
+			cos_te[i] = cos(te * M_PI / 180.0);
+			sin_te[i] = sin(te * M_PI / 180.0);
+		}
+		for (int i = 0; i < fiSize; ++i)
+		{
+			const int fi = i * fiStep - 90;
+			sin_fi[i] = sin(fi * M_PI / 180.0);
+			cos_fi[i] = cos(fi * M_PI / 180.0);
+		}
+	}
+
+	/**
+	 * Get shared instance, created on first use.
+	 */
+	static const ExplosionRays& get()
+	{
+		static const ExplosionRays rays;
+		return rays;
+	}
+};
+
+/**
+ * Checks whether toCheck is within circle sector defined by observer and two tangent points.
+ * @param toCheck The position to check.
+ * @param observerPos Position of observer, or invalid position for unlimited sector.
+ * @param sectorL Left tangent point relative to observer.
+ * @param sectorR Right tangent point relative to observer.
+ * @return true if within the circle sector.
+ */
+inline bool inVisibilitySector(const Position &toCheck, const Position &observerPos, const Position &sectorL, const Position &sectorR)
+{
+	if (observerPos != Position{ -1, -1, -1 })
+	{
+		Position posDiff = toCheck - observerPos;
+		//Is toCheck within the arc as defined by the two tangent points?
+		return (!(-sectorL.x * posDiff.y + sectorL.y * posDiff.x > 0) &&
+			(-sectorR.x * posDiff.y + sectorR.y * posDiff.x > 0));
+	}
+	else
+	{
+		return true;
+	}
+}
+
 } // namespace
 
 const int TileEngine::heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12};
@@ -215,6 +344,22 @@ const int TileEngine::heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12}
 
 constexpr Position TileEngine::invalid;
 
+/**
+ * Threads waiting for tile visibility jobs, kept for the whole battle.
+ * Jobs are handed out one by one with a counter.
+ */
+struct TileEngine::TileFOVPool
+{
+	SDL_mutex *lock;
+	SDL_cond *wake, *done;
+	std::vector<SDL_Thread*> threads;
+	/// Jobs of current call, null when there is nothing to do.
+	std::vector<TileFOVJob> *jobs;
+	/// Next job to hand out and count of jobs not finished yet.
+	size_t next, pending;
+	bool quit;
+};
+
 /**
  * Sets up a TileEngine.
  * @param save Pointer to SavedBattleGame object.
@@ -223,11 +368,11 @@ constexpr Position TileEngine::invalid;
  * @param maxDarknessToSeeUnits Threshold of darkness for LoS calculation.
  */
 TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
-	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventory("STR_GROUND", true)), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
+	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventory("STR_GROUND", true)), _explosionEpoch(0), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
 	_maxViewDistance(mod->getMaxViewDistance()), _maxViewDistanceSq(_maxViewDistance * _maxViewDistance),
 	_maxVoxelViewDistance(_maxViewDistance * 16), _maxDarknessToSeeUnits(mod->getMaxDarknessToSeeUnits()),
 	_maxStaticLightDistance(mod->getMaxStaticLightDistance()), _maxDynamicLightDistance(mod->getMaxDynamicLightDistance()),
-	_enhancedLighting(mod->getEnhancedLighting())
+	_enhancedLighting(mod->getEnhancedLighting()), _fovPool(0)
 {
 	_blockVisibility.resize(save->getMapSizeXYZ());
 	_cacheTilePos = Position(-1,-1,-1);
@@ -238,7 +383,21 @@ TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
  */
 TileEngine::~TileEngine()
 {
-
+	if (_fovPool)
+	{
+		SDL_mutexP(_fovPool->lock);
+		_fovPool->quit = true;
+		SDL_CondBroadcast(_fovPool->wake);
+		SDL_mutexV(_fovPool->lock);
+		for (std::vector<SDL_Thread*>::iterator i = _fovPool->threads.begin(); i != _fovPool->threads.end(); ++i)
+		{
+			SDL_WaitThread(*i, 0);
+		}
+		SDL_DestroyCond(_fovPool->wake);
+		SDL_DestroyCond(_fovPool->done);
+		SDL_DestroyMutex(_fovPool->lock);
+		delete _fovPool;
+	}
 }
 
 /**
@@ -398,6 +557,7 @@ void TileEngine::calculateUnitLighting(GraphSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	Profiler::Scope scope("TileEngine::calculateLighting");
 	auto gsDynamic = GraphSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsStatic = gsDynamic;
 
@@ -711,17 +871,7 @@ bool TileEngine::setupEventVisibilitySector(const Position &observerPos, const P
  */
 inline bool TileEngine::inEventVisibilitySector(const Position &toCheck) const
 {
-	if (_eventVisibilityObserverPos != Position{ -1, -1, -1 })
-	{
-		Position posDiff = toCheck - _eventVisibilityObserverPos;
-		//Is toCheck within the arc as defined by the two tangent points?
-		return (!(-_eventVisibilitySectorL.x * posDiff.y + _eventVisibilitySectorL.y * posDiff.x > 0) &&
-			(-_eventVisibilitySectorR.x * posDiff.y + _eventVisibilitySectorR.y * posDiff.x > 0));
-	}
-	else
-	{
-		return true;
-	}
+	return inVisibilitySector(toCheck, _eventVisibilityObserverPos, _eventVisibilitySectorL, _eventVisibilitySectorR);
 }
 
 /**
@@ -781,7 +931,7 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 								&& !unit->hasVisibleUnit((*i)))
 							{
 								unit->addToVisibleUnits((*i));
-								unit->addToVisibleTiles((*i)->getTile());
+								unit->addToVisibleTiles((*i)->getTile(), _save->getTileIndex((*i)->getTile()->getPosition()));
 
 								if (unit->getFaction() == FACTION_HOSTILE && (*i)->getFaction() != FACTION_HOSTILE)
 								{
@@ -820,6 +970,24 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 * @param eventRadius The radius of a circle able to fully encompass the event, in tiles. Hence: 1 for a singletile event.
 */
 void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos, const int eventRadius)
+{
+	TileFOVJob job;
+	if (prepareTilesInFOV(job, unit, eventPos, eventRadius))
+	{
+		traceTilesInFOV(job);
+		applyTilesInFOV(job);
+	}
+}
+
+/**
+ * Prepares tile visibility update of a unit. Does all changes of shared state that need to be done before tracing.
+ * @param job Job to fill.
+ * @param unit Unit to check line of sight of.
+ * @param eventPos The centre of the event which necessitated the FOV update.
+ * @param eventRadius The radius of a circle able to fully encompass the event, in tiles.
+ * @return True if job need to be traced.
+ */
+bool TileEngine::prepareTilesInFOV(TileFOVJob &job, BattleUnit *unit, const Position eventPos, const int eventRadius)
 {
 	bool useTurretDirection = false;
 	bool skipNarrowArcTest = false;
@@ -835,12 +1003,12 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 	if (unit->getFaction() != FACTION_PLAYER || (eventRadius == 1 && !unit->checkViewSector(eventPos, useTurretDirection)))
 	{
 		//The event wasn't meant for us and/or visible for us.
-		return;
+		return false;
 	}
 	else if (unit->isOut())
 	{
 		unit->clearVisibleTiles();
-		return;
+		return false;
 	}
 	Position posSelf = unit->getPosition();
 	if (setupEventVisibilitySector(posSelf, eventPos, eventRadius))
@@ -851,15 +1019,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 	}
 
 	//Only recalculate bresenham lines to tiles that are at the event or further away.
-	const int distanceSqrMin = skipNarrowArcTest ? 0 : std::max(distanceSq(posSelf, eventPos, false) - eventRadius * eventRadius, 0);
-
-	//Variables for finding the tiles to test based on the view direction.
-	Position posTest;
-	std::vector<Position> _trajectory;
-	bool swap = (direction == 0 || direction == 4);
-	const int signX[8] = { +1, +1, +1, +1, -1, -1, -1, -1 };
-	const int signY[8] = { -1, -1, -1, +1, +1, +1, -1, -1 };
-	int y1, y2;
+	job.distanceSqrMin = skipNarrowArcTest ? 0 : std::max(distanceSq(posSelf, eventPos, false) - eventRadius * eventRadius, 0);
 
 	if ((unit->getHeight() + unit->getFloatHeight() + -_save->getTile(unit->getPosition())->getTerrainLevel()) >= 24 + 4)
 	{
@@ -869,6 +1029,39 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 			++posSelf.z;
 		}
 	}
+
+	job.unit = unit;
+	job.posSelf = posSelf;
+	job.direction = direction;
+	job.sectorL = _eventVisibilitySectorL;
+	job.sectorR = _eventVisibilitySectorR;
+	job.sectorObserverPos = _eventVisibilityObserverPos;
+	job.newTiles.clear();
+	return true;
+}
+
+/**
+ * Traces lines of sight to all tiles within view cone of a prepared job.
+ * Only reads the map, so different jobs can be traced at same time.
+ * @param job Job to trace, newly visible tiles are added to its unit and list.
+ */
+void TileEngine::traceTilesInFOV(TileFOVJob &job)
+{
+	BattleUnit *unit = job.unit;
+	const Position posSelf = job.posSelf;
+	const int direction = job.direction;
+
+	//Variables for finding the tiles to test based on the view direction.
+	Position posTest;
+	std::vector<Position> _trajectory;
+	bool swap = (direction == 0 || direction == 4);
+	const int signX[8] = { +1, +1, +1, +1, -1, -1, -1, -1 };
+	const int signY[8] = { -1, -1, -1, +1, +1, +1, -1, -1 };
+	int y1, y2;
+
+	// large units have "4 pair of eyes"
+	const int size = unit->getArmor()->getSize();
+
 	//Test all tiles within view cone for visibility.
 	for (int x = 0; x <= getMaxViewDistance(); ++x) //TODO: Possible improvement: find the intercept points of the arc at max view distance and choose a more intelligent sweep of values when an event arc is defined.
 	{
@@ -885,12 +1078,12 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 		for (int y = y1; y <= y2; ++y) //TODO: Possible improvement: find the intercept points of the arc at max view distance and choose a more intelligent sweep of values when an event arc is defined.
 		{
 			const int distanceSqr = x*x + y*y;
-			if (distanceSqr <= getMaxViewDistanceSq() && distanceSqr >= distanceSqrMin)
+			if (distanceSqr <= getMaxViewDistanceSq() && distanceSqr >= job.distanceSqrMin)
 			{
 				posTest.x = posSelf.x + signX[direction] * (swap ? y : x);
 				posTest.y = posSelf.y + signY[direction] * (swap ? x : y);
 				//Only continue if the column of tiles at (x,y) is within the narrow arc of interest (if enabled)
-				if (inEventVisibilitySector(posTest))
+				if (inVisibilitySector(posTest, job.sectorObserverPos, job.sectorL, job.sectorR))
 				{
 					for (int z = 0; z < _save->getMapSizeZ(); z++)
 					{
@@ -899,8 +1092,6 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 						if (_save->getTile(posTest)) //inside map?
 						{
 							// this sets tiles to discovered if they are in LOS - tile visibility is not calculated in voxelspace but in tilespace
-							// large units have "4 pair of eyes"
-							int size = unit->getArmor()->getSize();
 							for (int xo = 0; xo < size; xo++)
 							{
 								for (int yo = 0; yo < size; yo++)
@@ -916,20 +1107,12 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 									//Reveal all tiles along line of vision. Note: needed due to width of bresenham stroke.
 									for (std::vector<Position>::iterator i = _trajectory.begin(); i != _trajectory.end(); ++i)
 									{
-										Position posVisited = (*i);
 										//Add tiles to the visible list only once. BUT we still need to calculate the whole trajectory as
 										// this bresenham line's period might be different from the one that originally revealed the tile.
-										if (!unit->hasVisibleTile(_save->getTile(posVisited)))
+										const int indexVisited = _save->getTileIndex(*i);
+										if (unit->markVisibleTile(_save->getTile(indexVisited), indexVisited))
 										{
-											unit->addToVisibleTiles(_save->getTile(posVisited));
-											_save->getTile(posVisited)->setVisible(+1);
-											_save->getTile(posVisited)->setDiscovered(true, 2);
-
-											// walls to the east or south of a visible tile, we see that too
-											Tile* t = _save->getTile(Position(posVisited.x + 1, posVisited.y, posVisited.z));
-											if (t) t->setDiscovered(true, 0);
-											t = _save->getTile(Position(posVisited.x, posVisited.y + 1, posVisited.z));
-											if (t) t->setDiscovered(true, 1);
+											job.newTiles.push_back(indexVisited);
 										}
 									}
 								}
@@ -942,6 +1125,118 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 	}
 }
 
+/**
+ * Traces multiple jobs. When worker threads are enabled jobs are split between them,
+ * each job is still traced by exactly one thread so results do not depend on thread count.
+ * @param jobs Jobs to trace.
+ */
+void TileEngine::traceTilesInFOV(std::vector<TileFOVJob> &jobs)
+{
+	if (jobs.size() < 2 || Options::battleFovThreads <= 1)
+	{
+		for (std::vector<TileFOVJob>::iterator i = jobs.begin(); i != jobs.end(); ++i)
+		{
+			traceTilesInFOV(*i);
+		}
+		return;
+	}
+
+	if (_fovPool == 0)
+	{
+		_fovPool = new TileFOVPool();
+		_fovPool->lock = SDL_CreateMutex();
+		_fovPool->wake = SDL_CreateCond();
+		_fovPool->done = SDL_CreateCond();
+		_fovPool->jobs = 0;
+		_fovPool->next = 0;
+		_fovPool->pending = 0;
+		_fovPool->quit = false;
+		// this thread traces jobs too
+		for (int i = 1; i < Options::battleFovThreads; ++i)
+		{
+			SDL_Thread *thread = SDL_CreateThread(traceTilesInFOVThread, this);
+			if (thread == 0)
+			{
+				break;
+			}
+			_fovPool->threads.push_back(thread);
+		}
+	}
+
+	// if no worker could be created all jobs end up traced here
+	SDL_mutexP(_fovPool->lock);
+	_fovPool->jobs = &jobs;
+	_fovPool->next = 0;
+	_fovPool->pending = jobs.size();
+	SDL_CondBroadcast(_fovPool->wake);
+	traceTilesInFOVPending();
+	while (_fovPool->pending > 0)
+	{
+		SDL_CondWait(_fovPool->done, _fovPool->lock);
+	}
+	_fovPool->jobs = 0;
+	SDL_mutexV(_fovPool->lock);
+}
+
+/**
+ * Takes jobs one by one until all are taken, the lock is released while a job is traced.
+ */
+void TileEngine::traceTilesInFOVPending()
+{
+	while (_fovPool->jobs && _fovPool->next < _fovPool->jobs->size())
+	{
+		TileFOVJob &job = (*_fovPool->jobs)[_fovPool->next++];
+		SDL_mutexV(_fovPool->lock);
+		traceTilesInFOV(job);
+		SDL_mutexP(_fovPool->lock);
+		if (--_fovPool->pending == 0)
+		{
+			SDL_CondSignal(_fovPool->done);
+		}
+	}
+}
+
+/**
+ * Waits for jobs and traces them until the engine is deleted.
+ * @param data Pointer to TileEngine.
+ * @return Always 0.
+ */
+int TileEngine::traceTilesInFOVThread(void *data)
+{
+	TileEngine *engine = (TileEngine*)data;
+	TileFOVPool *pool = engine->_fovPool;
+	SDL_mutexP(pool->lock);
+	while (!pool->quit)
+	{
+		engine->traceTilesInFOVPending();
+		SDL_CondWait(pool->wake, pool->lock);
+	}
+	SDL_mutexV(pool->lock);
+	return 0;
+}
+
+/**
+ * Marks tiles newly seen by unit of job as visible and discovered.
+ * @param job Traced job.
+ */
+void TileEngine::applyTilesInFOV(const TileFOVJob &job)
+{
+	for (std::vector<int>::const_iterator i = job.newTiles.begin(); i != job.newTiles.end(); ++i)
+	{
+		Tile *tile = _save->getTile(*i);
+		// one for the unit visible tiles list (see BattleUnit::addToVisibleTiles) and one for the line of sight.
+		tile->setVisible(+2);
+		tile->setDiscovered(true, 2);
+
+		// walls to the east or south of a visible tile, we see that too
+		const Position pos = tile->getPosition();
+		Tile* t = _save->getTile(Position(pos.x + 1, pos.y, pos.z));
+		if (t) t->setDiscovered(true, 0);
+		t = _save->getTile(Position(pos.x, pos.y + 1, pos.z));
+		if (t) t->setDiscovered(true, 1);
+	}
+}
+
 /**
 * Recalculates line of sight of a soldier.
 * @param unit Unit to check line of sight of.
@@ -951,6 +1246,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	Profiler::Scope scope("TileEngine::calculateFOV");
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -1392,6 +1688,7 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	Profiler::Scope scope("TileEngine::calculateFOV");
 	int updateRadius;
 	if (eventRadius == -1)
 	{
@@ -1404,6 +1701,8 @@ void TileEngine::calculateFOV(Position position, int eventRadius, const bool upd
 		updateRadius = getMaxViewDistance() + (eventRadius > 0 ? eventRadius : 0);
 		updateRadius *= updateRadius;
 	}
+	std::vector<BattleUnit*> units;
+	std::vector<TileFOVJob> jobs;
 	for (std::vector<BattleUnit*>::iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
 	{
 		if (distanceSq(position, (*i)->getPosition(), false) <= updateRadius) //could this unit have observed the event?
@@ -1414,12 +1713,27 @@ void TileEngine::calculateFOV(Position position, int eventRadius, const bool upd
 				{
 					(*i)->clearVisibleTiles();
 				}
-				calculateTilesInFOV((*i), position, eventRadius);
+				jobs.push_back(TileFOVJob());
+				if (!prepareTilesInFOV(jobs.back(), (*i), position, eventRadius))
+				{
+					jobs.pop_back();
+				}
 			}
-
-			calculateUnitsInFOV((*i), position, eventRadius);
+			units.push_back(*i);
 		}
 	}
+
+	// tiles of each unit are traced independently, shared tile state is updated afterwards in unit order.
+	traceTilesInFOV(jobs);
+	for (std::vector<TileFOVJob>::const_iterator i = jobs.begin(); i != jobs.end(); ++i)
+	{
+		applyTilesInFOV(*i);
+	}
+
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		calculateUnitsInFOV((*i), position, eventRadius);
+	}
 }
 
 /**
@@ -1481,69 +1795,80 @@ bool TileEngine::checkReactionFire(BattleUnit *unit, const BattleAction &origina
 std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit* unit)
 {
 	std::vector<TileEngine::ReactionScore> spotters;
-	Tile *tile = unit->getTile();
-	int threshold = unit->getReactionScore();
 	// no reaction on civilian turn.
-	if (_save->getSide() != FACTION_NEUTRAL)
+	if (_save->getSide() == FACTION_NEUTRAL)
 	{
-		for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+		return spotters;
+	}
+	Tile *tile = unit->getTile();
+	const Position position = unit->getPosition();
+	const UnitFaction side = _save->getSide();
+	const int threshold = unit->getReactionScore();
+	for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	{
+			// not a friend
+		if ((*i)->getFaction() == side ||
+			// not a civilian
+			(*i)->getFaction() == FACTION_NEUTRAL ||
+			// closer than 20 tiles
+			distanceSq(position, (*i)->getPosition(), false) > getMaxViewDistanceSq() ||
+			// not dead/unconscious
+			(*i)->isOut() ||
+			// not dying or not about to pass out
+			(*i)->isOutThresholdExceed() ||
+			// have any chances for reacting
+			(*i)->getReactionScore() < threshold)
 		{
-				// not dead/unconscious
-			if (!(*i)->isOut() &&
-				// not dying or not about to pass out
-				!(*i)->isOutThresholdExceed() &&
-				// have any chances for reacting
-				(*i)->getReactionScore() >= threshold &&
-				// not a friend
-				(*i)->getFaction() != _save->getSide() &&
-				// not a civilian
-				(*i)->getFaction() != FACTION_NEUTRAL &&
-				// closer than 20 tiles
-				distanceSq(unit->getPosition(), (*i)->getPosition(), false) <= getMaxViewDistanceSq())
+			continue;
+		}
+
+		AIModule *ai = (*i)->getAIModule();
+
+		// Inquisitor's note regarding 'gotHit' variable
+		// in vanilla, the 'hitState' flag is the only part of this equation that comes into play.
+		// any time a unit takes damage, this flag is set, then it would be reset by a call to
+		// a function analogous to SavedBattleGame::resetUnitHitStates(), any time:
+		// 1: a unit was selected by being clicked on.
+		// 2: either "next unit" button was pressed.
+		// 3: the inventory screen was accessed. (i didn't look too far into this one, it's possible it's only called in the pre-mission equip screen)
+		// 4: the same place where we call it, immediately before every move the AI makes.
+		// this flag is responsible for units turning around to respond to hits, and is in keeping with the details listed on http://www.ufopaedia.org/index.php/Reaction_fire_triggers
+		// we've gone for a slightly different implementation: AI units keep a list of which units have hit them and don't forget until the end of the player's turn.
+		// this method is in keeping with the spirit of the original feature, but much less exploitable by players.
+		// the hitState flag in our implementation allows player units to turn and react as they did in the original, (which is far less cumbersome than giving them all an AI module)
+		// we don't extend the same "enhanced aggressor memory" courtesy to players, because in the original, they could only turn and react to damage immediately after it happened.
+		// this is because as much as we want the player's soldiers dead, we don't want them to feel like we're being unfair about it.
+
+		bool gotHit = (ai != 0 && ai->getWasHitBy(unit->getId())) || (ai == 0 && (*i)->getHitState());
+
+		// can actually see the target Tile, or we got hit
+		if (!gotHit && !(*i)->checkViewSector(position))
+		{
+			continue;
+		}
+
+		// line of fire and line of sight are only traced for units that passed all cheaper checks above.
+		BattleAction falseAction;
+		falseAction.type = BA_SNAPSHOT;
+		falseAction.actor = *i;
+		falseAction.target = position;
+		Position originVoxel = getOriginVoxel(falseAction, 0);
+		Position targetVoxel;
+
+			// can actually target the unit
+		if (canTargetUnit(&originVoxel, tile, &targetVoxel, *i) &&
+			// can actually see the unit
+			visible(*i, tile))
+		{
+			if ((*i)->getFaction() == FACTION_PLAYER)
 			{
-				BattleAction falseAction;
-				falseAction.type = BA_SNAPSHOT;
-				falseAction.actor = *i;
-				falseAction.target = unit->getPosition();
-				Position originVoxel = getOriginVoxel(falseAction, 0);
-				Position targetVoxel;
-				AIModule *ai = (*i)->getAIModule();
-
-				// Inquisitor's note regarding 'gotHit' variable
-				// in vanilla, the 'hitState' flag is the only part of this equation that comes into play.
-				// any time a unit takes damage, this flag is set, then it would be reset by a call to
-				// a function analogous to SavedBattleGame::resetUnitHitStates(), any time:
-				// 1: a unit was selected by being clicked on.
-				// 2: either "next unit" button was pressed.
-				// 3: the inventory screen was accessed. (i didn't look too far into this one, it's possible it's only called in the pre-mission equip screen)
-				// 4: the same place where we call it, immediately before every move the AI makes.
-				// this flag is responsible for units turning around to respond to hits, and is in keeping with the details listed on http://www.ufopaedia.org/index.php/Reaction_fire_triggers
-				// we've gone for a slightly different implementation: AI units keep a list of which units have hit them and don't forget until the end of the player's turn.
-				// this method is in keeping with the spirit of the original feature, but much less exploitable by players.
-				// the hitState flag in our implementation allows player units to turn and react as they did in the original, (which is far less cumbersome than giving them all an AI module)
-				// we don't extend the same "enhanced aggressor memory" courtesy to players, because in the original, they could only turn and react to damage immediately after it happened.
-				// this is because as much as we want the player's soldiers dead, we don't want them to feel like we're being unfair about it.
-
-				bool gotHit = (ai != 0 && ai->getWasHitBy(unit->getId())) || (ai == 0 && (*i)->getHitState());
-
-					// can actually see the target Tile, or we got hit
-				if (((*i)->checkViewSector(unit->getPosition()) || gotHit) &&
-					// can actually target the unit
-					canTargetUnit(&originVoxel, tile, &targetVoxel, *i) &&
-					// can actually see the unit
-					visible(*i, tile))
-				{
-					if ((*i)->getFaction() == FACTION_PLAYER)
-					{
-						unit->setVisible(true);
-					}
-					(*i)->addToVisibleUnits(unit);
-					ReactionScore rs = determineReactionType(*i, unit);
-					if (rs.attackType != BA_NONE)
-					{
-						spotters.push_back(rs);
-					}
-				}
+				unit->setVisible(true);
+			}
+			(*i)->addToVisibleUnits(unit);
+			ReactionScore rs = determineReactionType(*i, unit);
+			if (rs.attackType != BA_NONE)
+			{
+				spotters.push_back(rs);
 			}
 		}
 	}
@@ -2142,9 +2467,21 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	int hitSide = 0;
 	int diagonalWall = 0;
 	int power_;
-	std::map<Tile*, int> tilesAffected;
+	std::vector<Tile*> tilesAffected;
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
+	const ExplosionRays& rays = ExplosionRays::get();
+
+	// new explosion invalidate all tiles visited by previous one.
+	if (_explosionVisited.size() != (size_t)_save->getMapSizeXYZ())
+	{
+		_explosionVisited.assign(_save->getMapSizeXYZ(), 0);
+		_explosionDamage.assign(_save->getMapSizeXYZ(), 0);
+	}
+	if (++_explosionEpoch == 0)
+	{
+		std::fill(_explosionVisited.begin(), _explosionVisited.end(), 0);
+		_explosionEpoch = 1;
+	}
 
 	if (type->FireBlastCalc)
 	{
@@ -2177,15 +2514,16 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	for (int fiIndex = 0; fiIndex < ExplosionRays::fiSize; ++fiIndex)
 	{
 		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
+		for (int teIndex = 0; teIndex < ExplosionRays::teSize; ++teIndex)
 		{
-			double cos_te = cos(te * M_PI / 180.0);
-			double sin_te = sin(te * M_PI / 180.0);
-			double sin_fi = sin(fi * M_PI / 180.0);
-			double cos_fi = cos(fi * M_PI / 180.0);
+			const int te = teIndex * ExplosionRays::teStep;
+			const double cos_te = rays.cos_te[teIndex];
+			const double sin_te = rays.sin_te[teIndex];
+			const double sin_fi = rays.sin_fi[fiIndex];
+			const double cos_fi = rays.cos_fi[fiIndex];
 
 			origin = _save->getTile(centetTile);
 			dest = origin;
@@ -2196,14 +2534,22 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			{
 				if (power_ > 0)
 				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+					// check if we had this tile already affected
+					const int index = _save->getTileIndex(dest->getPosition());
+					const bool firstVisit = _explosionVisited[index] != _explosionEpoch;
+					if (firstVisit)
+					{
+						_explosionVisited[index] = _explosionEpoch;
+						_explosionDamage[index] = 0;
+						tilesAffected.push_back(dest);
+					}
 
 					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
+					if (tileDmg > _explosionDamage[index])
 					{
-						ret.first->second = tileDmg;
+						_explosionDamage[index] = tileDmg;
 					}
-					if (ret.second)
+					if (firstVisit)
 					{
 						const int damage = type->getRandomDamage(power_);
 						BattleUnit *bu = dest->getUnit();
@@ -2319,14 +2665,16 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	// now detonate the tiles affected by explosion
 	if (type->ToTile > 0.0f)
 	{
-		for (std::map<Tile*, int>::iterator i = tilesAffected.begin(); i != tilesAffected.end(); ++i)
+		// tiles are stored in one array, map order was same as index order.
+		std::sort(tilesAffected.begin(), tilesAffected.end());
+		for (Tile* tile : tilesAffected)
 		{
-			if (detonate(i->first, i->second))
+			if (detonate(tile, _explosionDamage[_save->getTileIndex(tile->getPosition())]))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(i->first);
-			Tile *j = _save->getTile(i->first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
@@ -3121,6 +3469,9 @@ int TileEngine::calculateLine(Position origin, Position target, bool storeTrajec
 		excludeAllUnits = true; // don't start unit spotting before pre-game inventory stuff (large units on the craftInventory tile will cause a crash if they're "spotted")
 	}
 
+	// tile without terrain and units, line can cross it in one jump
+	Position emptyTile = TileEngine::invalid;
+
 	bool hit = calculateLineHitHelper(origin, target,
 		[&](Position point)
 		{
@@ -3140,6 +3491,10 @@ int TileEngine::calculateLine(Position origin, Position target, bool storeTrajec
 					}
 					return true;
 				}
+				if (!storeTrajectory && isTileVoxelEmpty(_cacheTile, _cacheTileBelow))
+				{
+					emptyTile = _cacheTilePos;
+				}
 			}
 			else
 			{
@@ -3183,6 +3538,17 @@ int TileEngine::calculateLine(Position origin, Position target, bool storeTrajec
 				}
 			}
 			return false;
+		},
+		[&](Position point, Position& low, Position& high)
+		{
+			//rest of empty tile can't hit anything, jump to its edge
+			if (point.x >= 0 && point.y >= 0 && point.z >= 0 && point / Position(16, 16, 24) == emptyTile)
+			{
+				low = emptyTile * Position(16, 16, 24);
+				high = low + Position(15, 15, 23);
+				return true;
+			}
+			return false;
 		}
 	);
 	if (hit)
@@ -3347,7 +3713,7 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 		_cacheTileBelow = tileBelow;
  	}
 
-	if (tile->isVoid() && tile->getUnit() == 0 && (!tileBelow || tileBelow->getUnit() == 0))
+	if (isTileVoxelEmpty(tile, tileBelow))
 	{
 		return V_EMPTY;
 	}
@@ -4046,11 +4412,31 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
+	Profiler::Scope scope("TileEngine::recalculateFOV");
+	std::vector<TileFOVJob> jobs;
+	for (std::vector<BattleUnit*>::iterator bu = _save->getUnits()->begin(); bu != _save->getUnits()->end(); ++bu)
+	{
+		if ((*bu)->getTile() != 0)
+		{
+			jobs.push_back(TileFOVJob());
+			if (!prepareTilesInFOV(jobs.back(), *bu, invalid, 0))
+			{
+				jobs.pop_back();
+			}
+		}
+	}
+
+	traceTilesInFOV(jobs);
+	for (std::vector<TileFOVJob>::const_iterator i = jobs.begin(); i != jobs.end(); ++i)
+	{
+		applyTilesInFOV(*i);
+	}
+
 	for (std::vector<BattleUnit*>::iterator bu = _save->getUnits()->begin(); bu != _save->getUnits()->end(); ++bu)
 	{
 		if ((*bu)->getTile() != 0)
 		{
-			calculateFOV(*bu);
+			calculateUnitsInFOV(*bu);
 		}
 	}
 }
@@ -82,6 +82,9 @@ private:
 	std::vector<Uint16> *_voxelData;
 	std::vector<VisibilityBlockCache> _blockVisibility;
 	RuleInventory *_inventorySlotGround;
+	std::vector<Uint32> _explosionVisited;
+	std::vector<int> _explosionDamage;
+	Uint32 _explosionEpoch;
 	static const int heightFromCenter[11];
 	bool _personalLighting;
 	Tile *_cacheTile;
@@ -118,6 +121,30 @@ private:
 	bool setupEventVisibilitySector(const Position &observerPos, const Position &eventPos, const int &eventRadius);
 	inline bool inEventVisibilitySector(const Position &toCheck) const;
 
+	/// Tile visibility update of one unit, traced independently of other units.
+	struct TileFOVJob
+	{
+		BattleUnit *unit;
+		Position posSelf, sectorL, sectorR, sectorObserverPos;
+		int direction, distanceSqrMin;
+		std::vector<int> newTiles;
+	};
+	/// Worker threads tracing tile visibility jobs, started on first use.
+	struct TileFOVPool;
+	TileFOVPool *_fovPool;
+	/// Prepares tile visibility update of a unit, returns false if there is nothing to trace.
+	bool prepareTilesInFOV(TileFOVJob &job, BattleUnit *unit, const Position eventPos, const int eventRadius);
+	/// Traces lines of sight of a job, changes only the job and its unit.
+	void traceTilesInFOV(TileFOVJob &job);
+	/// Traces all jobs, using worker threads if enabled.
+	void traceTilesInFOV(std::vector<TileFOVJob> &jobs);
+	/// Traces jobs not yet taken by other threads, called with pool lock held.
+	void traceTilesInFOVPending();
+	/// Entry point of worker thread of the pool.
+	static int traceTilesInFOVThread(void *data);
+	/// Marks tiles traced by a job as visible and discovered.
+	void applyTilesInFOV(const TileFOVJob &job);
+
 	/// Calculates sun shading of the whole map.
 	void calculateSunShading(GraphSubset gs);
 	/// Recalculates lighting of the battlescape for terrain.
@@ -30,28 +30,129 @@
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
 #include "../fmath.h"
+#include <algorithm>
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Bytes of composites kept in cache.
+ */
+const size_t CompositeCacheBudget = 4 * 1024 * 1024;
+
+} //namespace
+
+/**
+ * Orders composite keys for the cache index.
+ * @param other Key to compare with.
+ * @return True if this key goes first.
+ */
+bool UnitSpriteCache::Key::operator<(const Key &other) const
+{
+	if (shade != other.shade) return shade < other.shade;
+	if (burn != other.burn) return burn < other.burn;
+	if (recolor != other.recolor) return recolor < other.recolor;
+	if (parts.size() != other.parts.size()) return parts.size() < other.parts.size();
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		const Part &a = parts[i], &b = other.parts[i];
+		if (a.src != b.src) return a.src < b.src;
+		if (a.bodyPart != b.bodyPart) return a.bodyPart < b.bodyPart;
+		if (a.offX != b.offX) return a.offX < b.offX;
+		if (a.offY != b.offY) return a.offY < b.offY;
+		if (a.item != b.item) return a.item < b.item;
+	}
+	return false;
+}
+
+/**
+ * Creates an empty composite cache.
+ */
+UnitSpriteCache::UnitSpriteCache() : _bytes(0)
+{
+
+}
+
+/**
+ * Deletes all cached composites.
+ */
+UnitSpriteCache::~UnitSpriteCache()
+{
+	for (std::list<Entry>::iterator i = _entries.begin(); i != _entries.end(); ++i)
+	{
+		delete i->surface;
+	}
+}
+
+/**
+ * Gets a cached composite, marking it as recently used.
+ * @param key Sprites the composite is made of.
+ * @param x Returns horizontal offset of composite.
+ * @param y Returns vertical offset of composite.
+ * @return Composite or null if it's not cached.
+ */
+Surface *UnitSpriteCache::get(const Key &key, int &x, int &y)
+{
+	std::map<Key, std::list<Entry>::iterator>::iterator i = _index.find(key);
+	if (i == _index.end())
+	{
+		return 0;
+	}
+	_entries.splice(_entries.begin(), _entries, i->second);
+	x = i->second->x;
+	y = i->second->y;
+	return i->second->surface;
+}
+
+/**
+ * Adds a new composite, dropping least recently used ones over the budget.
+ * @param key Sprites the composite is made of.
+ * @param surface Composite, owned by the cache from now on.
+ * @param x Horizontal offset of composite.
+ * @param y Vertical offset of composite.
+ */
+void UnitSpriteCache::add(const Key &key, Surface *surface, int x, int y)
+{
+	Entry entry = { surface, x, y, 0 };
+	_entries.push_front(entry);
+	std::map<Key, std::list<Entry>::iterator>::iterator i = _index.insert(std::make_pair(key, _entries.begin())).first;
+	_entries.front().key = &i->first;
+	_bytes += surface->getWidth() * surface->getHeight();
+
+	while (_bytes > CompositeCacheBudget && _entries.size() > 1)
+	{
+		Entry &last = _entries.back();
+		_bytes -= last.surface->getWidth() * last.surface->getHeight();
+		delete last.surface;
+		_index.erase(_index.find(*last.key));
+		_entries.pop_back();
+	}
+}
+
 /**
  * Sets up a UnitSprite with the specified size and position.
  * @param width Width in pixels.
  * @param height Height in pixels.
  * @param x X position in pixels.
  * @param y Y position in pixels.
+ * @param cache Optional cache of composited sprites.
  */
-UnitSprite::UnitSprite(Surface* dest, Mod* mod, int frame, bool helmet) :
+UnitSprite::UnitSprite(Surface* dest, Mod* mod, int frame, bool helmet, UnitSpriteCache *cache) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(mod->getSurfaceSet("HANDOB.PCK")),
 	_fireSurface(mod->getSurfaceSet("SMOKE.PCK")),
 	_breathSurface(mod->getSurfaceSet("BREATH-1.PCK", false)),
+	_unitSurfaceArmor(0),
 	_dest(dest), _mod(mod),
 	_part(0), _animationFrame(frame), _drawingRoutine(0),
 	_helmet(helmet),
 	_x(0), _y(0), _shade(0), _burn(0),
-	_mask(0, 0)
+	_mask(0, 0),
+	_cache(cache), _recording(false)
 {
 
 }
@@ -158,6 +259,12 @@ void UnitSprite::blitItem(Part& item)
 	{
 		return;
 	}
+	if (_recording)
+	{
+		UnitSpriteCache::Part part = { item.src, item.bodyPart, item.offX, item.offY, true };
+		_cacheKey.parts.push_back(part);
+		return;
+	}
 	ScriptWorkerBlit work;
 	BattleItem::ScriptFill(&work, (item.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), item.bodyPart, _animationFrame, _shade);
 
@@ -178,6 +285,12 @@ void UnitSprite::blitBody(Part& body)
 	{
 		return;
 	}
+	if (_recording)
+	{
+		UnitSpriteCache::Part part = { body.src, body.bodyPart, body.offX, body.offY, false };
+		_cacheKey.parts.push_back(part);
+		return;
+	}
 	ScriptWorkerBlit work;
 	BattleUnit::ScriptFill(&work, _unit, body.bodyPart, _animationFrame, _shade, _burn);
 
@@ -188,6 +301,85 @@ void UnitSprite::blitBody(Part& body)
 	_dest->unlock();
 }
 
+/**
+ * Checks if the unit and its items use only default sprite scripts.
+ * These don't read the destination pixel, so sprites composited alone
+ * and then blitted give the same pixels as blitting them one by one.
+ * @return True if composite can be cached.
+ */
+bool UnitSprite::canCache() const
+{
+	const Armor *armor = _unit->getArmor();
+	if (!armor->getScript<ModScript::RecolorUnitSprite>().isDefault() || !armor->getScript<ModScript::SelectUnitSprite>().isDefault())
+	{
+		return false;
+	}
+	BattleItem *items[] = { _itemR, _itemL };
+	for (BattleItem *item : items)
+	{
+		if (item && (!item->getRules()->getScript<ModScript::RecolorItemSprite>().isDefault() || !item->getRules()->getScript<ModScript::SelectItemSprite>().isDefault()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Blits composite of recorded sprites, compositing it first if it's not cached yet.
+ */
+void UnitSprite::blitCached()
+{
+	const std::vector<UnitSpriteCache::Part> &parts = _cacheKey.parts;
+	if (parts.empty())
+	{
+		return;
+	}
+	_cacheKey.recolor = _unit->getRecolor();
+	_cacheKey.shade = _shade;
+	_cacheKey.burn = _burn;
+
+	int x = 0, y = 0;
+	Surface *composite = _cache->get(_cacheKey, x, y);
+	if (!composite)
+	{
+		x = parts[0].offX;
+		y = parts[0].offY;
+		int endX = x, endY = y;
+		for (std::vector<UnitSpriteCache::Part>::const_iterator i = parts.begin(); i != parts.end(); ++i)
+		{
+			x = std::min(x, i->offX);
+			y = std::min(y, i->offY);
+			endX = std::max(endX, i->offX + i->src->getWidth());
+			endY = std::max(endY, i->offY + i->src->getHeight());
+		}
+		composite = new Surface(endX - x, endY - y);
+		for (std::vector<UnitSpriteCache::Part>::const_iterator i = parts.begin(); i != parts.end(); ++i)
+		{
+			ScriptWorkerBlit work;
+			if (i->item)
+			{
+				BattleItem::ScriptFill(&work, (i->bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), i->bodyPart, _animationFrame, _shade);
+			}
+			else
+			{
+				BattleUnit::ScriptFill(&work, _unit, i->bodyPart, _animationFrame, _shade, _burn);
+			}
+			work.executeBlit(i->src, composite, i->offX - x, i->offY - y, _shade);
+		}
+		_cache->add(_cacheKey, composite, x, y);
+	}
+
+	// pixels are final, so plain copy through tile mask
+	ScriptWorkerBlit work;
+
+	_dest->lock();
+
+	work.executeBlit(composite, _dest, _x + x, _y + y, 0, _mask);
+
+	_dest->unlock();
+}
+
 /**
  * Draws a unit, using the drawing rules of the unit.
  * This function is called by Map, for each unit on the screen.
@@ -211,7 +403,12 @@ void UnitSprite::draw(BattleUnit* unit, int part, int x, int y, int shade, Graph
 	_itemR = getIfVisible(_unit->getRightHandWeapon());
 	_itemL = getIfVisible(_unit->getLeftHandWeapon());
 
-	_unitSurface = _mod->getSurfaceSet(_unit->getArmor()->getSpriteSheet());
+	// same armor is drawn many times per frame, once for each tile it covers.
+	if (_unitSurfaceArmor != _unit->getArmor())
+	{
+		_unitSurfaceArmor = _unit->getArmor();
+		_unitSurface = _mod->getSurfaceSet(_unitSurfaceArmor->getSpriteSheet());
+	}
 
 	_drawingRoutine = _unit->getArmor()->getDrawingRoutine();
 
@@ -257,8 +454,15 @@ void UnitSprite::draw(BattleUnit* unit, int part, int x, int y, int shade, Graph
 		&UnitSprite::drawRoutine21,
 		&UnitSprite::drawRoutine3,
 	};
-	// Call the matching routine
+	// Call the matching routine, sprites are only recorded when their composite can be cached
+	_recording = _cache && canCache();
+	_cacheKey.parts.clear();
 	(this->*(routines[_drawingRoutine]))();
+	if (_recording)
+	{
+		_recording = false;
+		blitCached();
+	}
 	// draw fire
 	if (unit->getFire() > 0)
 	{
@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <list>
+#include <map>
+#include <vector>
 #include "../Engine/Surface.h"
 #include "../Engine/Script.h"
 
@@ -27,6 +30,51 @@ class BattleUnit;
 class BattleItem;
 class SurfaceSet;
 class Mod;
+class Armor;
+
+/**
+ * Composited unit sprites reused between frames.
+ * Least recently used ones are dropped when over memory budget.
+ */
+class UnitSpriteCache
+{
+public:
+	/// Sprite blitted into a composite.
+	struct Part
+	{
+		Surface *src;
+		int bodyPart, offX, offY;
+		bool item;
+	};
+	/// Everything that decides pixels of a composite.
+	struct Key
+	{
+		std::vector<Part> parts;
+		std::vector<std::pair<Uint8, Uint8> > recolor;
+		int shade, burn;
+
+		bool operator<(const Key &other) const;
+	};
+private:
+	struct Entry
+	{
+		Surface *surface;
+		int x, y;
+		const Key *key;
+	};
+	std::list<Entry> _entries;
+	std::map<Key, std::list<Entry>::iterator> _index;
+	size_t _bytes;
+public:
+	/// Creates an empty cache.
+	UnitSpriteCache();
+	/// Deletes all composites.
+	~UnitSpriteCache();
+	/// Gets a composite and its offset, or null if it's not cached.
+	Surface *get(const Key &key, int &x, int &y);
+	/// Adds a composite, the cache takes ownership of it.
+	void add(const Key &key, Surface *surface, int x, int y);
+};
 
 /**
  * A class that renders a specific unit, given its render rules
@@ -51,12 +99,16 @@ private:
 	BattleUnit *_unit;
 	BattleItem *_itemR, *_itemL;
 	SurfaceSet *_unitSurface, *_itemSurface, *_fireSurface, *_breathSurface;
+	const Armor *_unitSurfaceArmor;
 	Surface *_dest;
 	Mod *_mod;
 	int _part, _animationFrame, _drawingRoutine;
 	bool _helmet;
 	int _x, _y, _shade, _burn;
 	GraphSubset _mask;
+	UnitSpriteCache *_cache;
+	bool _recording;
+	UnitSpriteCache::Key _cacheKey;
 
 	/// Drawing routine for XCom soldiers in overalls, sectoids (routine 0),
 	/// mutons (routine 10),
@@ -104,9 +156,13 @@ private:
 	void blitItem(Part& item);
 	/// Blit body sprite.
 	void blitBody(Part& body);
+	/// Check if unit is drawn only by default scripts.
+	bool canCache() const;
+	/// Blit composite of recorded sprites.
+	void blitCached();
 public:
 	/// Creates a new UnitSprite at the specified position and size.
-	UnitSprite(Surface* dest, Mod* mod, int frame, bool helmet);
+	UnitSprite(Surface* dest, Mod* mod, int frame, bool helmet, UnitSpriteCache *cache = 0);
 	/// Cleans up the UnitSprite.
 	~UnitSprite();
 	/// Draws the unit.
@@ -159,6 +159,7 @@ unsigned char* adl_gv_subtracks[128];
 unsigned int adl_gv_instruments_count = 0;
 unsigned int adl_gv_subtracks_count = 0;
 int adl_gv_polyphony_level = 0;
+int adl_gv_loop_count = 0;
 unsigned char adl_gv_chorus_instruments[16];
 int adl_gv_FORMAT = 0;//0 = without title, 1=with title
 UINT8 iFMReg[256];
@@ -817,6 +818,7 @@ void func_play_tick()
 			--instruments[instr].cur_delay;
 		}
 		if (!another_loop && adl_gv_music_playing) break;
+		if (another_loop) ++adl_gv_loop_count;
 		init_music();
 		clear_channels();
 	} while (another_loop);
@@ -878,3 +880,8 @@ int func_get_polyphony()
 {
 	return adl_gv_polyphony_level;
 }
+
+int func_get_loop_count()
+{
+	return adl_gv_loop_count;
+}
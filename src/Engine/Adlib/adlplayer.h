@@ -17,5 +17,7 @@ bool func_is_music_playing();
 void func_set_music_tempo(int value);
 void func_set_music_volume(int value);
 int func_get_polyphony();
+//returns how many times the music restarted from its loop point
+int func_get_loop_count();
 void func_save_music_state(int i);
 void func_load_music_state(int i);
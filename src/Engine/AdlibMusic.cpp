@@ -34,12 +34,23 @@ namespace OpenXcom
 int AdlibMusic::delay = 0;
 int AdlibMusic::rate = 0;
 std::map<int, int> AdlibMusic::delayRates;
+const AdlibMusic *AdlibMusic::pcmCurrent = 0;
+size_t AdlibMusic::pcmPosition = 0;
+int AdlibMusic::pcmLoops = 0;
+
+namespace
+{
+
+/// Longest track that will be pre-rendered, in seconds.
+const int PcmMaxSeconds = 10 * 60;
+
+}
 
 /**
  * Initializes a new music track.
  * @param volume Music volume modifier (1.0 = 100%).
  */
-AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume)
+AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume), _pcmDone(false), _pcmLoop(false)
 {
 	rate = Options::audioSampleRate;
 	if (!opl[0])
@@ -68,6 +79,11 @@ AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volu
  */
 AdlibMusic::~AdlibMusic()
 {
+	if (pcmCurrent == this)
+	{
+		stop();
+		pcmCurrent = 0;
+	}
 	if (opl[0])
 	{
 		stop();
@@ -116,6 +132,8 @@ void AdlibMusic::load(const void *data, int size)
 
 /**
  * Plays the contained music track.
+ * With pre-rendering the first pass is emulated and recorded
+ * like normal playback, later loops are played from the recording.
  * @param loop Amount of times to loop the track. -1 = infinite
  */
 void AdlibMusic::play(int) const
@@ -124,13 +142,96 @@ void AdlibMusic::play(int) const
 	if (!Options::mute)
 	{
 		stop();
-		func_setup_music((unsigned char*)_data, _size);
-		func_set_music_volume(127 * _volume);
+		if (Options::prerenderAdlibMusic)
+		{
+			// only the current track is kept in memory
+			if (pcmCurrent && pcmCurrent != this)
+			{
+				pcmCurrent->_pcm.clear();
+				pcmCurrent->_pcm.shrink_to_fit();
+				pcmCurrent->_pcmDone = false;
+			}
+			pcmCurrent = this;
+			pcmPosition = 0;
+		}
+		else
+		{
+			pcmCurrent = 0;
+		}
+		if (!pcmCurrent || !_pcmDone)
+		{
+			_pcm.clear();
+			_pcmLoop = false;
+			func_setup_music((unsigned char*)_data, _size);
+			func_set_music_volume(127 * _volume);
+			pcmLoops = func_get_loop_count();
+		}
 		Mix_HookMusic(player, (void*)this);
 	}
 #endif
 }
 
+/**
+ * Appends emulator output to the recording of the current track,
+ * then scales the output by the music volume.
+ * Tracks longer than the limit are not recorded.
+ * @param samples Emulator output at full volume.
+ * @param count Number of samples.
+ * @param volume Music volume.
+ */
+void AdlibMusic::recordPcm(Sint16 *samples, size_t count, float volume)
+{
+	std::vector<Sint16> &pcm = pcmCurrent->_pcm;
+	if (pcm.size() + count > (size_t)rate * 2 * PcmMaxSeconds)
+	{
+		Log(LOG_VERBOSE) << "Adlib track too long to pre-render";
+		pcm.clear();
+		pcm.shrink_to_fit();
+		pcmCurrent = 0;
+	}
+	else
+	{
+		pcm.insert(pcm.end(), samples, samples + count);
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		samples[i] = (Sint16)(samples[i] * volume);
+	}
+}
+
+/**
+ * Copies the pre-rendered data of the current track
+ * to the output, scaled by the music volume.
+ * @param stream Raw audio to output.
+ * @param len Length of audio to output.
+ */
+void AdlibMusic::playPcm(Uint8 *stream, int len)
+{
+	const std::vector<Sint16> &pcm = pcmCurrent->_pcm;
+	const bool loop = pcmCurrent->_pcmLoop || Options::musicAlwaysLoop;
+	const float volume = Game::volumeExponent(Options::musicVolume);
+	Sint16 *out = (Sint16*)stream;
+	size_t samples = len / 2;
+	while (samples != 0)
+	{
+		if (pcmPosition >= pcm.size())
+		{
+			if (!loop || pcm.empty())
+				return;
+			pcmPosition = 0;
+		}
+		size_t i = std::min(samples, pcm.size() - pcmPosition);
+		const Sint16 *in = &pcm[pcmPosition];
+		for (size_t j = 0; j < i; ++j)
+		{
+			out[j] = (Sint16)(in[j] * volume);
+		}
+		out += i;
+		pcmPosition += i;
+		samples -= i;
+	}
+}
+
 /**
  * Custom audio player.
  * @param udata User data to send to the player.
@@ -142,6 +243,11 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 #ifndef __NO_MUSIC
 	if (Options::musicVolume == 0)
 		return;
+	if (pcmCurrent && pcmCurrent->_pcmDone)
+	{
+		playPcm(stream, len);
+		return;
+	}
 	if (Options::musicAlwaysLoop && !func_is_music_playing())
 	{
 		AdlibMusic *music = (AdlibMusic*)udata;
@@ -156,8 +262,17 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 		if (i)
 		{
 			float volume = Game::volumeExponent(Options::musicVolume);
-			YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, volume);
-			YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, volume);
+			if (pcmCurrent)
+			{
+				YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, 1.0f);
+				YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, 1.0f);
+				recordPcm((Sint16*)stream, i / 2, volume);
+			}
+			else
+			{
+				YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, volume);
+				YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, volume);
+			}
 			stream += i;
 			delay -= i;
 			len -= i;
@@ -165,6 +280,17 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 		if (!len)
 			return;
 		func_play_tick();
+		if (pcmCurrent && (!func_is_music_playing() || func_get_loop_count() != pcmLoops))
+		{
+			// whole pass is recorded, a loop continues from its start
+			pcmCurrent->_pcmLoop = func_is_music_playing();
+			pcmCurrent->_pcmDone = true;
+			pcmPosition = pcmCurrent->_pcmLoop ? 0 : pcmCurrent->_pcm.size();
+			func_mute();
+			Log(LOG_VERBOSE) << "Pre-rendered Adlib track: " << pcmCurrent->_pcm.size() / 2 / rate << "s" << (pcmCurrent->_pcmLoop ? ", looping" : "");
+			playPcm(stream, len);
+			return;
+		}
 
 		delay = delayRates[rate];
 	}
@@ -176,6 +302,10 @@ bool AdlibMusic::isPlaying()
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
+		if (pcmCurrent == this && _pcmDone)
+		{
+			return _pcmLoop || Options::musicAlwaysLoop || pcmPosition < _pcm.size();
+		}
 		return func_is_music_playing();
 	}
 #endif
@@ -19,6 +19,7 @@
  */
 #include "Music.h"
 #include <map>
+#include <vector>
 #include <string>
 #include <SDL_mixer.h>
 
@@ -37,6 +38,22 @@ private:
 	float _volume;
 	static int delay, rate;
 	static std::map<int, int> delayRates;
+	/// Pre-rendered PCM data of the track (interleaved stereo), recorded while the track plays.
+	mutable std::vector<Sint16> _pcm;
+	/// Does the pre-rendered data hold a whole pass of the track?
+	mutable bool _pcmDone;
+	/// Does the pre-rendered track loop back to the start?
+	mutable bool _pcmLoop;
+	/// Track played from or recorded to pre-rendered data, 0 when only emulating.
+	static const AdlibMusic *pcmCurrent;
+	/// Position in the pre-rendered data of the current track.
+	static size_t pcmPosition;
+	/// Loop count of the emulator when recording started.
+	static int pcmLoops;
+	/// Stores emulator output of the current track and applies the volume to it.
+	static void recordPcm(Sint16 *samples, size_t count, float volume);
+	/// Copies pre-rendered data of the current track to the output.
+	static void playPcm(Uint8 *stream, int len);
 public:
 	/// Creates a blank music track.
 	AdlibMusic(float volume = 1.0f);
@@ -18,37 +18,63 @@
  */
 
 #include "CatFile.h"
+#include <fstream>
+#include <algorithm>
+#include <string.h>
 #include <SDL.h>
 
 namespace OpenXcom
 {
 
 /**
- * Creates a CAT file stream. A CAT file starts with an index of the
+ * Creates a CAT file reader. A CAT file starts with an index of the
  * offset and size of every file contained within. Each file consists
  * of a filename followed by its contents.
  * @param path Full path to CAT file.
  */
-CatFile::CatFile(const char *path) : std::ifstream(path, std::ios::in | std::ios::binary), _amount(0), _offset(0), _size(0)
+CatFile::CatFile(const char *path) : _loaded(false), _amount(0)
 {
-	// Get amount of files
-	read((char*)&_amount, sizeof(_amount));
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		return;
+	}
+	file.seekg(0, std::ios::end);
+	std::streamoff length = file.tellg();
+	file.seekg(0, std::ios::beg);
+	if (length < (std::streamoff)sizeof(Uint32))
+	{
+		return;
+	}
+	_data.resize((size_t)length);
+	if (!file.read(&_data[0], length))
+	{
+		_data.clear();
+		return;
+	}
+	_loaded = true;
 
-	_amount = (unsigned int)SDL_SwapLE32(_amount);
-	_amount /= 2 * sizeof(_amount);
+	// Get amount of files
+	Uint32 first;
+	memcpy(&first, &_data[0], sizeof(first));
+	_amount = (unsigned int)SDL_SwapLE32(first);
+	_amount /= 2 * sizeof(first);
+	// an index larger than the file means a broken file
+	if (_amount * 2 * sizeof(first) > _data.size())
+	{
+		_amount = _data.size() / (2 * sizeof(first));
+	}
 
 	// Get object offsets
-	seekg(0, std::ios::beg);
-
-	_offset = new unsigned int[_amount];
-	_size   = new unsigned int[_amount];
-
+	_offset.resize(_amount);
+	_size.resize(_amount);
 	for (unsigned int i = 0; i < _amount; ++i)
 	{
-		read((char*)&_offset[i], sizeof(*_offset));
-		_offset[i] = (unsigned int)SDL_SwapLE32(_offset[i]);
-		read((char*)&_size[i],   sizeof(*_size));
-		_size[i] = (unsigned int)SDL_SwapLE32(_size[i]);
+		Uint32 value;
+		memcpy(&value, &_data[i * 2 * sizeof(value)], sizeof(value));
+		_offset[i] = (unsigned int)SDL_SwapLE32(value);
+		memcpy(&value, &_data[i * 2 * sizeof(value) + sizeof(value)], sizeof(value));
+		_size[i] = (unsigned int)SDL_SwapLE32(value);
 	}
 }
 
@@ -57,14 +83,39 @@ CatFile::CatFile(const char *path) : std::ifstream(path, std::ios::in | std::ios
  */
 CatFile::~CatFile()
 {
-	delete[] _offset;
-	delete[] _size;
 
-	close();
 }
 
 /**
- * Loads an object into memory.
+ * Gets an object straight from the file in memory,
+ * skipping its internal file name. The pointer stays
+ * valid as long as the CatFile.
+ * @param i Object number to get.
+ * @param size Returns the size of the object, cut short if the file is.
+ * @return Pointer to the object, 0 if there's no such object.
+ */
+const char *CatFile::getObject(unsigned int i, unsigned int *size) const
+{
+	*size = 0;
+	if (i >= _amount || _offset[i] >= _data.size())
+		return 0;
+
+	size_t start = _offset[i];
+	unsigned char namesize = _data[start];
+	// Skip filename (if there's any)
+	if (namesize<=56)
+	{
+		start += namesize + 1;
+	}
+	if (start >= _data.size())
+		return 0;
+
+	*size = (unsigned int)std::min<size_t>(_size[i], _data.size() - start);
+	return &_data[start];
+}
+
+/**
+ * Loads a copy of an object into memory.
  * @param i Object number to load.
  * @param name Preserve internal file name.
  * @return Pointer to the loaded object.
@@ -74,15 +125,14 @@ char *CatFile::load(unsigned int i, bool name)
 	if (i >= _amount)
 		return 0;
 
-	seekg(_offset[i], std::ios::beg);
-
-	unsigned char namesize = peek();
+	size_t start = std::min<size_t>(_offset[i], _data.size());
+	unsigned char namesize = start < _data.size() ? _data[start] : 0;
 	// Skip filename (if there's any)
 	if (namesize<=56)
 	{
 		if (!name)
 		{
-			seekg(namesize + 1, std::ios::cur);
+			start = std::min<size_t>(start + namesize + 1, _data.size());
 		}
 		else
 		{
@@ -90,9 +140,9 @@ char *CatFile::load(unsigned int i, bool name)
 		}
 	}
 
-	// Read object
-	char *object = new char[_size[i]];
-	read(object, _size[i]);
+	// Read object, missing bytes of a cut short file stay zero
+	char *object = new char[_size[i]]();
+	memcpy(object, &_data[0] + start, std::min<size_t>(_size[i], _data.size() - start));
 
 	return object;
 }
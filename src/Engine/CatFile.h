@@ -17,27 +17,31 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <fstream>
+#include <vector>
 
 namespace OpenXcom
 {
 
 /**
- * Subclass of std::ifstream to handle CAT files
+ * Reader of CAT files, the whole file is read into memory
+ * at once and objects are handed out straight from it.
  */
-class CatFile : protected std::ifstream
+class CatFile
 {
 private:
-	unsigned int _amount, *_offset, *_size;
+	std::vector<char> _data;
+	bool _loaded;
+	unsigned int _amount;
+	std::vector<unsigned int> _offset, _size;
 public:
-	/// Creates a CAT file stream.
+	/// Creates a CAT file reader.
 	CatFile(const char *path);
-	/// Cleans up the stream.
+	/// Cleans up the reader.
 	~CatFile();
-	/// Inherit operator.
+	/// Checks if the file failed to load.
 	bool operator !() const
 	{
-		return std::ifstream::operator!();
+		return !_loaded;
 	}
 	/// Get amount of objects.
 	int getAmount() const
@@ -49,6 +53,8 @@ public:
 	{
 		return (i < _amount) ? _size[i] : 0;
 	}
+	/// Gets an object without copying it.
+	const char *getObject(unsigned int i, unsigned int *size) const;
 	/// Load an object into memory.
 	char *load(unsigned int i, bool name = false);
 };
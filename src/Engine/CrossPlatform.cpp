@@ -707,6 +707,24 @@ time_t getDateModified(const std::string &path)
 	}
 }
 
+/**
+ * Gets the size of a file.
+ * @param path Full path to file.
+ * @return The size in bytes, 0 if it can't be read.
+ */
+Uint64 getFileSize(const std::string &path)
+{
+	struct stat info;
+	if (stat(path.c_str(), &info) == 0)
+	{
+		return info.st_size;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
 /**
  * Converts a date/time into a human-readable string
  * using the ISO 8601 standard.
@@ -79,6 +79,8 @@ namespace CrossPlatform
 	bool isQuitShortcut(const SDL_Event &ev);
 	/// Gets the modified date of a file.
 	time_t getDateModified(const std::string &path);
+	/// Gets the size of a file.
+	Uint64 getFileSize(const std::string &path);
 	/// Converts a timestamp to a string.
 	std::pair<std::wstring, std::wstring> timeToString(time_t time);
 	/// Compares two strings by natural order.
@@ -22,6 +22,9 @@
 #include "CrossPlatform.h"
 #include <map>
 #include <algorithm>
+#include <fstream>
+#include <ctime>
+#include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
 {
@@ -107,22 +110,45 @@ static std::string _combinePath(const std::string &prefixPath, const std::string
 	return ret;
 }
 
-static void _mapFiles(const std::string &modId, const std::string &basePath,
+/**
+ * Directory tree of one mapped folder, as found by _scanFiles.
+ * Kept in traversal order, so replaying it maps the same resources as the walk did.
+ */
+struct FolderIndex
+{
+	bool ignoreMods;
+	time_t scanned;
+	/// Relative paths of scanned directories with their modification times.
+	std::vector<std::pair<std::string, time_t> > dirs;
+	/// Index into dirs and file names of ruleset files, per directory recording rulesets.
+	std::vector<std::pair<size_t, std::vector<std::string> > > rulesets;
+	/// Index into dirs and names of resource files.
+	std::vector<std::pair<size_t, std::string> > files;
+};
+
+static std::map<std::string, FolderIndex> _indexCache;
+static bool _indexCacheChanged = false;
+
+static void _scanFiles(FolderIndex &index, const std::string &basePath,
 		      const std::string &relPath, bool ignoreMods)
 {
 	std::string fullDir = basePath + (relPath.length() ? "/" + relPath : "");
 	std::vector<std::string> files = CrossPlatform::getFolderContents(fullDir);
 	std::set<std::string> rulesetFiles = _filterFiles(files, "rul");
 
+	// directories changed in the same second as the scan could change again
+	// without a new modification time, so they are never trusted
+	size_t dir = index.dirs.size();
+	time_t modified = CrossPlatform::getDateModified(fullDir);
+	if (modified + 1 >= index.scanned)
+	{
+		modified = 0;
+	}
+	index.dirs.push_back(std::make_pair(relPath, modified));
+
 	if (!ignoreMods && !rulesetFiles.empty())
 	{
-		_rulesets.insert(_rulesets.begin(), std::pair<std::string, std::vector<std::string> >(modId, std::vector<std::string>()));
-		for (std::set<std::string>::iterator i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
-		{
-			std::string fullpath = fullDir + "/" + *i;
-			Log(LOG_VERBOSE) << "  recording ruleset: " << fullpath;
-			_rulesets.front().second.push_back(fullpath);
-		}
+		index.rulesets.push_back(std::make_pair(dir, std::vector<std::string>(rulesetFiles.begin(), rulesetFiles.end())));
 	}
 
 	for (std::vector<std::string>::iterator i = files.begin(); i != files.end(); ++i)
@@ -144,12 +170,36 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 			// record ruleset files in that subdirectory, otherwise ignore them
 			bool ignoreModsRecurse = ignoreMods ||
 				!rulesetFiles.empty() || !relPath.empty() || _canonicalize(*i) != "ruleset";
-			_mapFiles(modId, basePath, _combinePath(relPath, *i), ignoreModsRecurse);
+			_scanFiles(index, basePath, _combinePath(relPath, *i), ignoreModsRecurse);
 			continue;
 		}
 
+		index.files.push_back(std::make_pair(dir, *i));
+	}
+}
+
+static void _mapFiles(const std::string &modId, const std::string &basePath, const FolderIndex &index)
+{
+	for (std::vector<std::pair<size_t, std::vector<std::string> > >::const_iterator i = index.rulesets.begin(); i != index.rulesets.end(); ++i)
+	{
+		const std::string &relPath = index.dirs[i->first].first;
+		std::string fullDir = basePath + (relPath.length() ? "/" + relPath : "");
+		_rulesets.insert(_rulesets.begin(), std::pair<std::string, std::vector<std::string> >(modId, std::vector<std::string>()));
+		for (std::vector<std::string>::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+		{
+			std::string fullpath = fullDir + "/" + *j;
+			Log(LOG_VERBOSE) << "  recording ruleset: " << fullpath;
+			_rulesets.front().second.push_back(fullpath);
+		}
+	}
+
+	for (std::vector<std::pair<size_t, std::string> >::const_iterator i = index.files.begin(); i != index.files.end(); ++i)
+	{
+		const std::string &relPath = index.dirs[i->first].first;
+		std::string fullpath = basePath + (relPath.length() ? "/" + relPath : "") + "/" + i->second;
+
 		// populate resource map
-		std::string canonicalRelativeFilePath = _canonicalize(_combinePath(relPath, *i));
+		std::string canonicalRelativeFilePath = _canonicalize(_combinePath(relPath, i->second));
 		if (_resources.insert(std::pair<std::string, std::string>(canonicalRelativeFilePath, fullpath)).second)
 		{
 			Log(LOG_VERBOSE) << "  mapped resource: " << canonicalRelativeFilePath << " -> " << fullpath;
@@ -161,7 +211,7 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 
 		// populate vdir map
 		std::string canonicalRelativePath = _canonicalize(relPath);
-		std::string canonicalFile = _canonicalize(*i);
+		std::string canonicalFile = _canonicalize(i->second);
 		if (_vdirs.find(canonicalRelativePath) == _vdirs.end())
 		{
 			_vdirs.insert(std::pair< std::string, std::set<std::string> >(canonicalRelativePath, std::set<std::string>()));
@@ -173,6 +223,59 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 	}
 }
 
+/**
+ * Checks if a cached index still matches the folder on disk.
+ * Adding, removing or renaming entries updates the modification time
+ * of the directory holding them, so files need no checks of their own.
+ */
+static bool _isIndexValid(const FolderIndex &index, const std::string &basePath, bool ignoreMods)
+{
+	if (index.ignoreMods != ignoreMods || index.dirs.empty())
+	{
+		return false;
+	}
+	for (std::vector<std::pair<std::string, time_t> >::const_iterator i = index.dirs.begin(); i != index.dirs.end(); ++i)
+	{
+		std::string fullDir = basePath + (i->first.length() ? "/" + i->first : "");
+		if (i->second == 0 || CrossPlatform::getDateModified(fullDir) != i->second)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks if an index read from the cache file was written in full.
+ * A save cut short can still leave valid YAML with shorter lists,
+ * so the sizes saved with the index must match and every entry must point to a known directory.
+ */
+static bool _isIndexComplete(const FolderIndex &index, const YAML::Node &counts)
+{
+	if (!counts.IsSequence() || counts.size() != 3 ||
+		counts[0].as<size_t>() != index.dirs.size() ||
+		counts[1].as<size_t>() != index.rulesets.size() ||
+		counts[2].as<size_t>() != index.files.size())
+	{
+		return false;
+	}
+	for (std::vector<std::pair<size_t, std::vector<std::string> > >::const_iterator i = index.rulesets.begin(); i != index.rulesets.end(); ++i)
+	{
+		if (i->first >= index.dirs.size())
+		{
+			return false;
+		}
+	}
+	for (std::vector<std::pair<size_t, std::string> >::const_iterator i = index.files.begin(); i != index.files.end(); ++i)
+	{
+		if (i->first >= index.dirs.size())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void clear()
 {
 	_rulesets.clear();
@@ -183,7 +286,113 @@ void clear()
 void load(const std::string &modId, const std::string &path, bool ignoreMods)
 {
 	Log(LOG_VERBOSE) << "  mapping resources in: " << path;
-	_mapFiles(modId, path, "", ignoreMods);
+	std::map<std::string, FolderIndex>::iterator cached = _indexCache.find(path);
+	if (cached != _indexCache.end() && _isIndexValid(cached->second, path, ignoreMods))
+	{
+		Log(LOG_VERBOSE) << "  using cached index of: " << path;
+		_mapFiles(modId, path, cached->second);
+		return;
+	}
+
+	FolderIndex index;
+	index.ignoreMods = ignoreMods;
+	index.scanned = time(0);
+	_scanFiles(index, path, "", ignoreMods);
+	_mapFiles(modId, path, index);
+	_indexCache[path] = index;
+	_indexCacheChanged = true;
+}
+
+void loadIndexCache(const std::string &filename)
+{
+	_indexCache.clear();
+	_indexCacheChanged = false;
+	if (!CrossPlatform::fileExists(filename))
+	{
+		return;
+	}
+	try
+	{
+		YAML::Node doc = YAML::LoadFile(filename);
+		for (YAML::const_iterator i = doc["folders"].begin(); i != doc["folders"].end(); ++i)
+		{
+			FolderIndex index;
+			index.ignoreMods = (*i)["ignoreMods"].as<bool>(false);
+			index.scanned = 0;
+			for (YAML::const_iterator j = (*i)["dirs"].begin(); j != (*i)["dirs"].end(); ++j)
+			{
+				index.dirs.push_back(std::make_pair((*j)[0].as<std::string>(), (time_t)(*j)[1].as<long long>()));
+			}
+			for (YAML::const_iterator j = (*i)["rulesets"].begin(); j != (*i)["rulesets"].end(); ++j)
+			{
+				index.rulesets.push_back(std::make_pair((*j)[0].as<size_t>(), (*j)[1].as<std::vector<std::string> >()));
+			}
+			for (YAML::const_iterator j = (*i)["files"].begin(); j != (*i)["files"].end(); ++j)
+			{
+				index.files.push_back(std::make_pair((*j)[0].as<size_t>(), (*j)[1].as<std::string>()));
+			}
+			std::string path = (*i)["path"].as<std::string>();
+			if (!_isIndexComplete(index, (*i)["counts"]))
+			{
+				// rescanned on load, same as a changed folder
+				Log(LOG_WARNING) << "Ignoring damaged resource index of " << path << " in " << filename;
+				continue;
+			}
+			_indexCache[path] = index;
+		}
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_WARNING) << "Ignoring resource index " << filename << ": " << e.what();
+		_indexCache.clear();
+	}
+}
+
+void saveIndexCache(const std::string &filename)
+{
+	if (!_indexCacheChanged)
+	{
+		return;
+	}
+	YAML::Emitter out;
+	out << YAML::BeginMap << YAML::Key << "folders" << YAML::Value << YAML::BeginSeq;
+	for (std::map<std::string, FolderIndex>::const_iterator i = _indexCache.begin(); i != _indexCache.end(); ++i)
+	{
+		out << YAML::BeginMap;
+		out << YAML::Key << "path" << YAML::Value << i->first;
+		out << YAML::Key << "ignoreMods" << YAML::Value << i->second.ignoreMods;
+		out << YAML::Key << "counts" << YAML::Value << YAML::Flow << YAML::BeginSeq << i->second.dirs.size() << i->second.rulesets.size() << i->second.files.size() << YAML::EndSeq;
+		out << YAML::Key << "dirs" << YAML::Value << YAML::BeginSeq;
+		for (std::vector<std::pair<std::string, time_t> >::const_iterator j = i->second.dirs.begin(); j != i->second.dirs.end(); ++j)
+		{
+			out << YAML::Flow << YAML::BeginSeq << j->first << (long long)j->second << YAML::EndSeq;
+		}
+		out << YAML::EndSeq;
+		out << YAML::Key << "rulesets" << YAML::Value << YAML::BeginSeq;
+		for (std::vector<std::pair<size_t, std::vector<std::string> > >::const_iterator j = i->second.rulesets.begin(); j != i->second.rulesets.end(); ++j)
+		{
+			out << YAML::Flow << YAML::BeginSeq << j->first << j->second << YAML::EndSeq;
+		}
+		out << YAML::EndSeq;
+		out << YAML::Key << "files" << YAML::Value << YAML::BeginSeq;
+		for (std::vector<std::pair<size_t, std::string> >::const_iterator j = i->second.files.begin(); j != i->second.files.end(); ++j)
+		{
+			out << YAML::Flow << YAML::BeginSeq << j->first << j->second << YAML::EndSeq;
+		}
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+	}
+	out << YAML::EndSeq << YAML::EndMap;
+
+	std::ofstream sav(filename.c_str());
+	if (!sav)
+	{
+		Log(LOG_WARNING) << "Failed to save resource index " << filename;
+		return;
+	}
+	sav << out.c_str() << std::endl;
+	sav.close();
+	_indexCacheChanged = false;
 }
 
 bool isResourcesEmpty(void)
@@ -57,6 +57,13 @@ namespace FileMap
 	/// returned by getMods().
 	void load(const std::string &modId, const std::string &path, bool ignoreMods);
 
+	/// Reads directory trees scanned in previous runs, load() reuses them for folders
+	/// whose directories all kept their modification times.
+	void loadIndexCache(const std::string &filename);
+
+	/// Writes the directory trees scanned by load(), if any folder had to be scanned again.
+	void saveIndexCache(const std::string &filename);
+
 	/// Determines if _resources set is empty
 	bool isResourcesEmpty(void);
 }
@@ -117,7 +117,7 @@ void Font::init(size_t index, const std::wstring &str)
 			rect.y = startY;
 			rect.w = image->width;
 			rect.h = image->height;
-			_chars[str[i]] = std::make_pair(index, rect);
+			setChar(str[i], index, rect);
 		}
 	}
 	else
@@ -155,12 +155,72 @@ void Font::init(size_t index, const std::wstring &str)
 			rect.w = right - left + 1;
 			rect.h = image->height;
 
-			_chars[str[i]] = std::make_pair(index, rect);
+			setChar(str[i], index, rect);
 		}
 	}
 	surface->unlock();
 }
 
+/**
+ * Stores the size and position of a character, so it can be
+ * looked up directly by its code without searching.
+ * @param c Font character.
+ * @param index The index of the surface containing the character.
+ * @param rect Position and size of the character in the surface.
+ */
+void Font::setChar(wchar_t c, size_t index, const SDL_Rect &rect)
+{
+	FontChar chr;
+	chr.image = (int)index;
+	chr.rect = rect;
+	if ((Uint32)c <= 0xFFFF)
+	{
+		if (_pages.empty())
+		{
+			_pages.resize(256);
+		}
+		std::vector<FontChar> &page = _pages[(c >> 8) & 0xFF];
+		if (page.empty())
+		{
+			FontChar none = { -1, { 0, 0, 0, 0 } };
+			page.resize(256, none);
+		}
+		page[c & 0xFF] = chr;
+	}
+	else
+	{
+		_extraChars[c] = chr;
+	}
+}
+
+/**
+ * Finds the size and position of a character.
+ * @param c Font character.
+ * @return Pointer to the character data, or 0 if it's not in the font.
+ */
+const FontChar *Font::findChar(wchar_t c) const
+{
+	if ((Uint32)c <= 0xFFFF)
+	{
+		if (_pages.empty())
+		{
+			return 0;
+		}
+		const std::vector<FontChar> &page = _pages[(c >> 8) & 0xFF];
+		if (page.empty() || page[c & 0xFF].image < 0)
+		{
+			return 0;
+		}
+		return &page[c & 0xFF];
+	}
+	std::unordered_map<wchar_t, FontChar>::const_iterator i = _extraChars.find(c);
+	if (i == _extraChars.end())
+	{
+		return 0;
+	}
+	return &i->second;
+}
+
 /**
  * Returns a particular character from the set stored in the font.
  * @param c Character to use for size/position.
@@ -169,12 +229,13 @@ void Font::init(size_t index, const std::wstring &str)
  */
 Surface *Font::getChar(wchar_t c)
 {
-	if (_chars.find(c) == _chars.end())
+	const FontChar *chr = findChar(c);
+	if (chr == 0)
 	{
 		return 0;
 	}
-	Surface *surface = _images[_chars[c].first].surface;
-	*surface->getCrop() = _chars[c].second;
+	Surface *surface = _images[chr->image].surface;
+	*surface->getCrop() = chr->rect;
 	return surface;
 }
 
@@ -217,12 +278,21 @@ SDL_Rect Font::getCharSize(wchar_t c)
 	SDL_Rect size = { 0, 0, 0, 0 };
 	if (c != TOK_FLIP_COLORS && !isLinebreak(c) && !isSpace(c))
 	{
-		if (_chars.find(c) == _chars.end()) 
-			c = L'?';
+		const FontChar *chr = findChar(c);
+		if (chr == 0)
+			chr = findChar(L'?');
 
-		FontImage *image = &_images[_chars[c].first];
-		size.w = _chars[c].second.w + image->spacing;
-		size.h = _chars[c].second.h + image->spacing;
+		if (chr != 0)
+		{
+			FontImage *image = &_images[chr->image];
+			size.w = chr->rect.w + image->spacing;
+			size.h = chr->rect.h + image->spacing;
+		}
+		else
+		{
+			size.w = _images[0].spacing;
+			size.h = _images[0].spacing;
+		}
 	}
 	else
 	{
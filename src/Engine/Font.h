@@ -17,8 +17,8 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <map>
 #include <vector>
+#include <unordered_map>
 #include <utility>
 #include <string>
 #include <SDL.h>
@@ -36,6 +36,12 @@ struct FontImage
 	Surface *surface;
 };
 
+struct FontChar
+{
+	int image;
+	SDL_Rect rect;
+};
+
 /**
  * Takes care of loading and storing each character in a sprite font.
  * Sprite fonts consist of a set of characters split in fixed-size regions.
@@ -46,10 +52,17 @@ class Font
 {
 private:
 	std::vector<FontImage> _images;
-	std::map< wchar_t, std::pair<size_t, SDL_Rect> > _chars;
+	/// Characters in the Basic Multilingual Plane, in pages of 256 indexed by the high byte.
+	std::vector< std::vector<FontChar> > _pages;
+	/// Characters outside the Basic Multilingual Plane.
+	std::unordered_map<wchar_t, FontChar> _extraChars;
 	bool _monospace;
 	/// Determines the size and position of each character in the font.
 	void init(size_t index, const std::wstring &str);
+	/// Stores the size and position of a character.
+	void setChar(wchar_t c, size_t index, const SDL_Rect &rect);
+	/// Finds the size and position of a character.
+	const FontChar *findChar(wchar_t c) const;
 public:
 	/* Special text tokens */
 	static const wchar_t TOK_BREAK_SMALLLINE = 2;		// line break and change to small font
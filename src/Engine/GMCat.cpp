@@ -362,29 +362,26 @@ Music *GMCatFile::loadMIDI(unsigned int i)
 {
 	Music *music = new Music;
 
-	unsigned char *raw = static_cast<unsigned char*> ((void*)load(i));
+	unsigned int size = 0;
+	const unsigned char *raw = reinterpret_cast<const unsigned char*>(getObject(i, &size));
 
 	if (!raw)
 		return music;
 
 	// stream info
 	struct gmstream stream;
-	if (gmext_read_stream(&stream, getObjectSize(i), raw) == -1) {
-		delete[] raw;
+	if (gmext_read_stream(&stream, size, raw) == -1) {
 		return music;
 	}
 
 	std::vector<unsigned char> midi;
 	midi.reserve(65536);
 
-	// fields in stream still point into raw
+	// fields in stream still point into the file
 	if (gmext_write_midi(&stream, midi) == -1) {
-		delete[] raw;
 		return music;
 	}
 
-	delete[] raw;
-
 	music->load(&midi[0], midi.size());
 
 	return music;
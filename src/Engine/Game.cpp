@@ -21,6 +21,8 @@
 #include <cmath>
 #include <sstream>
 #include <SDL_mixer.h>
+#include <SDL_thread.h>
+#include <yaml-cpp/yaml.h>
 #include "State.h"
 #include "Screen.h"
 #include "Sound.h"
@@ -29,6 +31,7 @@
 #include "Logger.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
@@ -37,6 +40,7 @@
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "Profiler.h"
 #include "../Menu/TestState.h"
 
 namespace OpenXcom
@@ -44,12 +48,25 @@ namespace OpenXcom
 
 const double Game::VOLUME_GRADIENT = 10.0;
 
+/**
+ * Save file written by background thread.
+ */
+struct Game::BackgroundSave
+{
+	SavedGameSnapshot snapshot;
+	std::string filename, error;
+	std::function<void(const std::string &error)> done;
+	SDL_Thread *thread;
+	SDL_mutex *lock;
+	bool finished;
+};
+
 /**
  * Starts up SDL with all the subsystems and SDL_mixer for audio processing,
  * creates the display screen and sets up the cursor.
  * @param title Title of the game window.
  */
-Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _mouseActive(true), _timeUntilNextFrame(0)
+Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _mouseActive(true), _timeUntilNextFrame(0), _backgroundSave(0)
 {
 	Options::reload = false;
 	Options::mute = false;
@@ -98,6 +115,10 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create profiler overlay, profiling from the start catches mod loading
+	Profiler::setEnabled(Options::profiler);
+	_profilerOverlay = new ProfilerOverlay(160, 80, 0, 6);
+
 	// Create blank language
 	_lang = new Language();
 
@@ -109,9 +130,21 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
  */
 Game::~Game()
 {
+	if (_backgroundSave)
+	{
+		// nobody is left to show the result.
+		_backgroundSave->done = nullptr;
+		finishBackgroundSave(true);
+	}
+
 	Sound::stop();
 	Music::stop();
 
+	if (Profiler::isEnabled())
+	{
+		toggleProfiler();
+	}
+
 	for (std::list<State*>::iterator i = _states.begin(); i != _states.end(); ++i)
 	{
 		delete *i;
@@ -125,6 +158,7 @@ Game::~Game()
 	delete _mod;
 	delete _screen;
 	delete _fpsCounter;
+	delete _profilerOverlay;
 
 	Mix_CloseAudio();
 
@@ -152,6 +186,12 @@ void Game::run()
 			_deleted.pop_back();
 		}
 
+		// Report finished save
+		if (_backgroundSave)
+		{
+			finishBackgroundSave(false);
+		}
+
 		// Initialize active state
 		if (!_init)
 		{
@@ -251,6 +291,11 @@ void Game::run()
 								Options::debugUi = !Options::debugUi;
 								_states.back()->redrawText();
 							}
+							// "ctrl-p" profiler
+							else if (action.getDetails()->key.keysym.sym == SDLK_p && (SDL_GetModState() & KMOD_CTRL) != 0)
+							{
+								toggleProfiler();
+							}
 						}
 					}
 					_states.back()->handle(&action);
@@ -262,8 +307,12 @@ void Game::run()
 		if (runningState != PAUSED)
 		{
 			// Process logic
-			_states.back()->think();
+			{
+				Profiler::Scope scope("State::think");
+				_states.back()->think();
+			}
 			_fpsCounter->think();
+			_profilerOverlay->think();
 			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
 			{
 				// Update our FPS delay time based on the time of the last draw.
@@ -289,13 +338,21 @@ void Game::run()
 				}
 				while (i != _states.begin() && !(*i)->isScreen());
 
-				for (; i != _states.end(); ++i)
 				{
-					(*i)->blit();
+					Profiler::Scope scope("State::blit");
+					for (; i != _states.end(); ++i)
+					{
+						(*i)->blit();
+					}
 				}
 				_fpsCounter->blit(_screen->getSurface());
+				_profilerOverlay->blit(_screen->getSurface());
 				_cursor->blit(_screen->getSurface());
-				_screen->flip();
+				{
+					Profiler::Scope scope("Screen::flip");
+					_screen->flip();
+				}
+				Profiler::endFrame();
 			}
 		}
 
@@ -318,6 +375,7 @@ void Game::run()
  */
 void Game::quit()
 {
+	waitForSave();
 	// Always save ironman
 	if (_save != 0 && _save->isIronman() && !_save->getName().empty())
 	{
@@ -389,6 +447,15 @@ Cursor *Game::getCursor() const
 	return _cursor;
 }
 
+/**
+ * Returns the overlay showing the profiler's frame breakdown.
+ * @return Pointer to the ProfilerOverlay.
+ */
+ProfilerOverlay *Game::getProfilerOverlay() const
+{
+	return _profilerOverlay;
+}
+
 /**
  * Returns the FpsCounter used by the game.
  * @return Pointer to the FpsCounter.
@@ -522,6 +589,25 @@ void Game::loadMods()
 	_mod->loadAll(FileMap::getRulesets());
 }
 
+/**
+ * Starts recording hot paths of the engine, or stops it
+ * and writes what was recorded to a chrome://tracing
+ * file in the user folder.
+ */
+void Game::toggleProfiler()
+{
+	if (Profiler::isEnabled())
+	{
+		Profiler::writeTrace(Options::getUserFolder() + "profile_" + CrossPlatform::now() + ".json");
+		Profiler::setEnabled(false);
+	}
+	else
+	{
+		Profiler::setEnabled(true);
+	}
+	_profilerOverlay->setVisible(Profiler::isEnabled());
+}
+
 /**
  * Sets whether the mouse is activated.
  * If it is, mouse events are processed, otherwise
@@ -652,4 +738,108 @@ void Game::initAudio()
 	}
 }
 
+/**
+ * Writes a saved game to file without blocking the game. Snapshot is first written
+ * to a backup file, then moved over the save, so a failed write never damages existing save.
+ * Only one save is written at a time, previous one is finished before starting a new one.
+ * @param snapshot Saved game converted to YAML.
+ * @param filename Name of save file in user folder.
+ * @param done Called from main loop after writing, with error message or empty string when successful.
+ */
+void Game::saveInBackground(const SavedGameSnapshot &snapshot, const std::string &filename, std::function<void(const std::string &error)> done)
+{
+	waitForSave();
+
+	_backgroundSave = new BackgroundSave{ snapshot, filename, "", done, 0, SDL_CreateMutex(), false };
+	_backgroundSave->thread = SDL_CreateThread(writeBackgroundSave, _backgroundSave);
+	if (!_backgroundSave->thread)
+	{
+		writeBackgroundSave(_backgroundSave);
+		finishBackgroundSave(true);
+	}
+}
+
+/**
+ * Waits until background save is written and reports its result.
+ */
+void Game::waitForSave()
+{
+	if (_backgroundSave)
+	{
+		finishBackgroundSave(true);
+	}
+}
+
+/**
+ * Writes the save file. Touches nothing outside of the given save,
+ * result is picked up by main thread.
+ * @param data Pointer to BackgroundSave.
+ * @return Always 0.
+ */
+int Game::writeBackgroundSave(void *data)
+{
+	BackgroundSave *save = (BackgroundSave*)data;
+	std::string error;
+	try
+	{
+		std::string backup = save->filename + ".bak";
+		SavedGame::writeSnapshot(save->snapshot, backup);
+		std::string fullPath = Options::getMasterUserFolder() + save->filename;
+		std::string bakPath = Options::getMasterUserFolder() + backup;
+		if (!CrossPlatform::moveFile(bakPath, fullPath))
+		{
+			throw Exception("Save backed up in " + backup);
+		}
+	}
+	catch (Exception &e)
+	{
+		error = e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		error = e.what();
+	}
+
+	SDL_mutexP(save->lock);
+	save->error = error;
+	save->finished = true;
+	SDL_mutexV(save->lock);
+	return 0;
+}
+
+/**
+ * Cleans up a finished background save and calls its callback.
+ * @param wait Wait for save to finish, otherwise do nothing if it's still writing.
+ */
+void Game::finishBackgroundSave(bool wait)
+{
+	BackgroundSave *save = _backgroundSave;
+	if (!wait)
+	{
+		SDL_mutexP(save->lock);
+		bool finished = save->finished;
+		SDL_mutexV(save->lock);
+		if (!finished)
+		{
+			return;
+		}
+	}
+	if (save->thread)
+	{
+		SDL_WaitThread(save->thread, 0);
+	}
+	SDL_DestroyMutex(save->lock);
+	_backgroundSave = 0;
+
+	if (!save->error.empty())
+	{
+		Log(LOG_ERROR) << save->error;
+	}
+	if (save->done)
+	{
+		save->done(save->error);
+	}
+	delete save;
+}
+
 }
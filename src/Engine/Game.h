@@ -19,6 +19,7 @@
  */
 #include <list>
 #include <string>
+#include <functional>
 #include <SDL.h>
 
 namespace OpenXcom
@@ -31,6 +32,8 @@ class Language;
 class SavedGame;
 class Mod;
 class FpsCounter;
+class ProfilerOverlay;
+struct SavedGameSnapshot;
 
 /**
  * The core of the game engine, manages the game's entire contents and structure.
@@ -50,11 +53,21 @@ private:
 	Mod *_mod;
 	bool _quit, _init;
 	FpsCounter *_fpsCounter;
+	ProfilerOverlay *_profilerOverlay;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
+	struct BackgroundSave;
+	BackgroundSave *_backgroundSave;
 	static const double VOLUME_GRADIENT;
 
+	/// Writes save file, run by background thread.
+	static int writeBackgroundSave(void *data);
+	/// Cleans up background save if it's done (or wait is set), reporting result.
+	void finishBackgroundSave(bool wait);
+	/// Starts the profiler, or stops it and writes its trace.
+	void toggleProfiler();
+
 public:
 	/// Creates a new game and initializes SDL.
 	Game(const std::string &title);
@@ -74,6 +87,8 @@ public:
 	Cursor *getCursor() const;
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const;
+	/// Gets the profiler overlay.
+	ProfilerOverlay *getProfilerOverlay() const;
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
@@ -102,6 +117,10 @@ public:
 	void defaultLanguage();
 	/// Sets up the audio.
 	void initAudio();
+	/// Writes a saved game snapshot to file in background.
+	void saveInBackground(const SavedGameSnapshot &snapshot, const std::string &filename, std::function<void(const std::string &error)> done);
+	/// Waits until background save is written.
+	void waitForSave();
 };
 
 }
@@ -0,0 +1,136 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <stddef.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Pool of memory blocks for objects of one type.
+ * Blocks are allocated in chunks and never move, freed blocks are reused by next allocations.
+ * Used by class specific operator new and delete of often created objects.
+ */
+template<typename T>
+class ObjectPool
+{
+	union Block
+	{
+		Block *next;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+	};
+	static constexpr size_t ChunkSize = 256;
+
+	std::vector<Block*> _chunks;
+	Block *_free;
+	size_t _live, _allocations;
+
+public:
+	/// Creates empty pool.
+	ObjectPool() : _free(nullptr), _live(0), _allocations(0)
+	{
+
+	}
+	/// Releases memory of pool, if some objects are still alive memory is left to them.
+	~ObjectPool()
+	{
+		trim();
+	}
+
+	/**
+	 * Gets memory for one object, objects of other sizes (like derived classes) use global new.
+	 * @param size Size of requested memory.
+	 * @return Pointer to memory.
+	 */
+	void *allocate(size_t size)
+	{
+		if (size != sizeof(T))
+		{
+			return ::operator new(size);
+		}
+		if (_free == nullptr)
+		{
+			Block *chunk = static_cast<Block*>(::operator new(sizeof(Block) * ChunkSize));
+			for (size_t i = 0; i < ChunkSize; ++i)
+			{
+				chunk[i].next = (i + 1 < ChunkSize) ? &chunk[i + 1] : nullptr;
+			}
+			_chunks.push_back(chunk);
+			_free = chunk;
+		}
+		Block *block = _free;
+		_free = block->next;
+		++_live;
+		++_allocations;
+		return block;
+	}
+
+	/**
+	 * Returns memory of one object to pool.
+	 * @param p Pointer from allocate.
+	 * @param size Size of object.
+	 */
+	void deallocate(void *p, size_t size)
+	{
+		if (p == nullptr)
+		{
+			return;
+		}
+		if (size != sizeof(T))
+		{
+			::operator delete(p);
+			return;
+		}
+		Block *block = static_cast<Block*>(p);
+		block->next = _free;
+		_free = block;
+		--_live;
+	}
+
+	/**
+	 * Releases all chunks back to system, only done when there are no live objects.
+	 */
+	void trim()
+	{
+		if (_live == 0)
+		{
+			for (typename std::vector<Block*>::iterator i = _chunks.begin(); i != _chunks.end(); ++i)
+			{
+				::operator delete(*i);
+			}
+			_chunks.clear();
+			_free = nullptr;
+		}
+	}
+
+	/// Gets number of objects currently alive.
+	size_t getLive() const { return _live; }
+	/// Gets number of objects that fit in allocated chunks.
+	size_t getCapacity() const { return _chunks.size() * ChunkSize; }
+	/// Gets number of allocations done since start.
+	size_t getAllocations() const { return _allocations; }
+};
+
+template<typename T>
+constexpr size_t ObjectPool<T>::ChunkSize;
+
+}
@@ -76,6 +76,8 @@ void create()
 	_info.push_back(OptionInfo("maxFrameSkip", &maxFrameSkip, 0));
 	_info.push_back(OptionInfo("traceAI", &traceAI, false));
 	_info.push_back(OptionInfo("verboseLogging", &verboseLogging, false));
+	_info.push_back(OptionInfo("resourceIndexCache", &resourceIndexCache, true)); // skip scanning unchanged mod folders on startup
+	_info.push_back(OptionInfo("spriteCache", &spriteCache, true)); // skip decoding unchanged PNG sprites on startup
 	_info.push_back(OptionInfo("StereoSound", &StereoSound, true));
 	//_info.push_back(OptionInfo("baseXResolution", &baseXResolution, Screen::ORIGINAL_WIDTH));
 	//_info.push_back(OptionInfo("baseYResolution", &baseYResolution, Screen::ORIGINAL_HEIGHT));
@@ -108,7 +110,10 @@ void create()
 	_info.push_back(OptionInfo("battleXcomSpeed", &battleXcomSpeed, 30));
 	_info.push_back(OptionInfo("battleAlienSpeed", &battleAlienSpeed, 30));
 	_info.push_back(OptionInfo("battleNewPreviewPath", (int*)&battleNewPreviewPath, PATH_NONE)); // requires double-click to confirm move
+	_info.push_back(OptionInfo("battleFovThreads", &battleFovThreads, 4)); // threads tracing FOV of multiple units, 1 to disable
 	_info.push_back(OptionInfo("fpsCounter", &fpsCounter, false));
+	_info.push_back(OptionInfo("profiler", &profiler, false)); // record hot paths from startup, ctrl-p in debug mode toggles it and writes a trace
+	_info.push_back(OptionInfo("scriptProfiler", &scriptProfiler, false)); // count calls and time of mod scripts, report is logged at battle end or by ctrl-s in battlescape debug mode
 	_info.push_back(OptionInfo("globeDetail", &globeDetail, true));
 	_info.push_back(OptionInfo("globeRadarLines", &globeRadarLines, true));
 	_info.push_back(OptionInfo("globeFlightPaths", &globeFlightPaths, true));
@@ -139,6 +144,7 @@ void create()
 	_info.push_back(OptionInfo("preferredSound", (int*)&preferredSound, SOUND_AUTO));
 	_info.push_back(OptionInfo("preferredVideo", (int*)&preferredVideo, VIDEO_FMV));
 	_info.push_back(OptionInfo("musicAlwaysLoop", &musicAlwaysLoop, false));
+	_info.push_back(OptionInfo("prerenderAdlibMusic", &prerenderAdlibMusic, false));
 	_info.push_back(OptionInfo("touchEnabled", &touchEnabled, false));
 	_info.push_back(OptionInfo("rootWindowedMode", &rootWindowedMode, false));
 
@@ -760,6 +766,10 @@ void mapResources()
 {
 	Log(LOG_INFO) << "Mapping resource files...";
 	FileMap::clear();
+	if (resourceIndexCache)
+	{
+		FileMap::loadIndexCache(_userFolder + "resources.idx");
+	}
 
 	for (std::vector< std::pair<std::string, bool> >::reverse_iterator i = mods.rbegin(); i != mods.rend(); ++i)
 	{
@@ -781,6 +791,10 @@ void mapResources()
 	}
 	// TODO: Figure out why we still need to check common here
 	FileMap::load("common", CrossPlatform::searchDataFolder("common"), true);
+	if (resourceIndexCache)
+	{
+		FileMap::saveIndexCache(_userFolder + "resources.idx");
+	}
 	Log(LOG_INFO) << "Resources files mapped successfully.";
 }
 
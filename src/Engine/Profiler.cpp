@@ -0,0 +1,241 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+#include "Logger.h"
+#include <SDL_thread.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <algorithm>
+#include <string.h>
+
+namespace OpenXcom
+{
+namespace Profiler
+{
+
+/// One recorded section, times in microseconds since recording started.
+struct Section
+{
+	const char *name;
+	std::string detail;
+	Uint32 thread;
+	double start, duration;
+};
+
+/// Sections kept for the trace file, older half is dropped once reached.
+static const size_t MAX_SECTIONS = 1 << 19;
+
+/// Read by sections of any thread, written by the main thread.
+static std::atomic<bool> _enabled(false);
+static SDL_mutex *_lock = 0;
+static Uint32 _mainThread = 0;
+static std::chrono::steady_clock::time_point _epoch;
+static std::vector<Section> _sections;
+static std::map<Uint32, std::vector<size_t> > _open;
+static size_t _frameFirst = 0;
+static double _frameStart = 0, _frameTime = 0;
+static std::vector<std::pair<const char*, double> > _breakdown;
+
+static double _now()
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+bool isEnabled()
+{
+	return _enabled;
+}
+
+void setEnabled(bool enabled)
+{
+	if (_lock == 0)
+	{
+		_lock = SDL_CreateMutex();
+	}
+	SDL_mutexP(_lock);
+	if (enabled && !_enabled)
+	{
+		_mainThread = SDL_ThreadID();
+		_epoch = std::chrono::steady_clock::now();
+		_sections.clear();
+		_open.clear();
+		_frameFirst = 0;
+		_frameStart = 0;
+		_frameTime = 0;
+		_breakdown.clear();
+	}
+	_enabled = enabled;
+	SDL_mutexV(_lock);
+}
+
+void begin(const char *name, const std::string &detail)
+{
+	Section section;
+	section.name = name;
+	section.detail = detail;
+	section.thread = SDL_ThreadID();
+	section.duration = 0;
+	SDL_mutexP(_lock);
+	section.start = _now();
+	_open[section.thread].push_back(_sections.size());
+	_sections.push_back(section);
+	SDL_mutexV(_lock);
+}
+
+void end()
+{
+	Uint32 thread = SDL_ThreadID();
+	SDL_mutexP(_lock);
+	std::vector<size_t> &open = _open[thread];
+	if (!open.empty())
+	{
+		Section &section = _sections[open.back()];
+		section.duration = _now() - section.start;
+		open.pop_back();
+	}
+	SDL_mutexV(_lock);
+}
+
+void endFrame()
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+	SDL_mutexP(_lock);
+	double now = _now();
+	_frameTime = (now - _frameStart) / 1000.0;
+
+	// other threads (like loading) don't take frame time
+	_breakdown.clear();
+	for (size_t i = _frameFirst; i < _sections.size(); ++i)
+	{
+		if (_sections[i].thread != _mainThread)
+		{
+			continue;
+		}
+		std::vector<std::pair<const char*, double> >::iterator j = _breakdown.begin();
+		while (j != _breakdown.end() && strcmp(j->first, _sections[i].name) != 0)
+		{
+			++j;
+		}
+		if (j == _breakdown.end())
+		{
+			_breakdown.push_back(std::make_pair(_sections[i].name, 0.0));
+			j = _breakdown.end() - 1;
+		}
+		j->second += _sections[i].duration / 1000.0;
+	}
+	std::stable_sort(_breakdown.begin(), _breakdown.end(),
+		[](const std::pair<const char*, double> &a, const std::pair<const char*, double> &b) { return a.second > b.second; });
+
+	Section frame;
+	frame.name = "Frame";
+	frame.thread = _mainThread;
+	frame.start = _frameStart;
+	frame.duration = now - _frameStart;
+	_sections.push_back(frame);
+
+	// open sections are referenced by index, so only trim when there are none
+	if (_sections.size() > MAX_SECTIONS)
+	{
+		bool open = false;
+		for (std::map<Uint32, std::vector<size_t> >::const_iterator i = _open.begin(); i != _open.end(); ++i)
+		{
+			open = open || !i->second.empty();
+		}
+		if (!open)
+		{
+			_sections.erase(_sections.begin(), _sections.begin() + _sections.size() / 2);
+		}
+	}
+	_frameFirst = _sections.size();
+	_frameStart = now;
+	SDL_mutexV(_lock);
+}
+
+const std::vector<std::pair<const char*, double> > &getFrameBreakdown()
+{
+	return _breakdown;
+}
+
+double getFrameTime()
+{
+	return _frameTime;
+}
+
+static void _writeString(std::ostream &out, const std::string &s)
+{
+	out << '"';
+	for (std::string::const_iterator i = s.begin(); i != s.end(); ++i)
+	{
+		if (*i == '"' || *i == '\\')
+		{
+			out << '\\' << *i;
+		}
+		else if ((unsigned char)*i < 0x20)
+		{
+			out << ' ';
+		}
+		else
+		{
+			out << *i;
+		}
+	}
+	out << '"';
+}
+
+bool writeTrace(const std::string &filename)
+{
+	std::ofstream out(filename.c_str());
+	if (!out)
+	{
+		Log(LOG_WARNING) << "Failed to write profiler trace " << filename;
+		return false;
+	}
+	out.setf(std::ios::fixed);
+	out.precision(3);
+	SDL_mutexP(_lock);
+	out << "{\"traceEvents\":[";
+	out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << _mainThread << ",\"args\":{\"name\":\"main\"}}";
+	for (std::vector<Section>::const_iterator i = _sections.begin(); i != _sections.end(); ++i)
+	{
+		out << ",\n{\"name\":";
+		_writeString(out, i->name);
+		out << ",\"cat\":\"openxcom\",\"ph\":\"X\",\"pid\":1,\"tid\":" << i->thread << ",\"ts\":" << i->start << ",\"dur\":" << i->duration;
+		if (!i->detail.empty())
+		{
+			out << ",\"args\":{\"detail\":";
+			_writeString(out, i->detail);
+			out << "}";
+		}
+		out << "}";
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+	SDL_mutexV(_lock);
+	Log(LOG_INFO) << "Profiler trace written to " << filename;
+	return true;
+}
+
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace OpenXcom
+{
+
+/**
+ * Records how long sections of engine code take, for the frame
+ * breakdown overlay and chrome://tracing files.
+ * Off by default, sections of each thread are kept apart,
+ * the frame breakdown only counts the main thread.
+ */
+namespace Profiler
+{
+	/// Checks if sections are recorded.
+	bool isEnabled();
+
+	/// Starts or stops recording from the main thread, starting drops everything recorded before.
+	void setEnabled(bool enabled);
+
+	/// Starts a section, must be matched by end(). The name must outlive the profiler (use literals).
+	void begin(const char *name, const std::string &detail = "");
+
+	/// Ends the last started section.
+	void end();
+
+	/// Marks the end of a drawn frame and updates the frame breakdown.
+	void endFrame();
+
+	/// Gets the time spent in each kind of section during the last frame, in milliseconds, longest first.
+	const std::vector<std::pair<const char*, double> > &getFrameBreakdown();
+
+	/// Gets the length of the last frame in milliseconds.
+	double getFrameTime();
+
+	/// Writes all recorded sections as a chrome://tracing JSON file.
+	bool writeTrace(const std::string &filename);
+
+	/**
+	 * Records the code between its creation and destruction as a section.
+	 */
+	class Scope
+	{
+	private:
+		bool _active;
+	public:
+		/// Starts a section if the profiler is enabled.
+		Scope(const char *name) : _active(isEnabled())
+		{
+			if (_active) begin(name);
+		}
+		/// Starts a section with extra detail for the trace, like a mod name.
+		Scope(const char *name, const std::string &detail) : _active(isEnabled())
+		{
+			if (_active) begin(name, detail);
+		}
+		/// Ends the section.
+		~Scope()
+		{
+			if (_active) end();
+		}
+	};
+}
+
+}
@@ -21,6 +21,8 @@
 #include <iomanip>
 #include <tuple>
 #include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 #include "Logger.h"
 #include "Options.h"
@@ -61,6 +63,20 @@ namespace OpenXcom
 	MACRO_COPY_64(Func, (Pos) + 0x80) \
 	MACRO_COPY_64(Func, (Pos) + 0xC0)
 
+#define MACRO_COPY_HEX_16(Func, Hi) \
+	Func(Hi##0) Func(Hi##1) Func(Hi##2) Func(Hi##3) \
+	Func(Hi##4) Func(Hi##5) Func(Hi##6) Func(Hi##7) \
+	Func(Hi##8) Func(Hi##9) Func(Hi##A) Func(Hi##B) \
+	Func(Hi##C) Func(Hi##D) Func(Hi##E) Func(Hi##F)
+/**
+ * Same as MACRO_COPY_256 but every position is single token like `0x3A`, can be used to build names.
+ */
+#define MACRO_COPY_HEX_256(Func) \
+	MACRO_COPY_HEX_16(Func, 0x0) MACRO_COPY_HEX_16(Func, 0x1) MACRO_COPY_HEX_16(Func, 0x2) MACRO_COPY_HEX_16(Func, 0x3) \
+	MACRO_COPY_HEX_16(Func, 0x4) MACRO_COPY_HEX_16(Func, 0x5) MACRO_COPY_HEX_16(Func, 0x6) MACRO_COPY_HEX_16(Func, 0x7) \
+	MACRO_COPY_HEX_16(Func, 0x8) MACRO_COPY_HEX_16(Func, 0x9) MACRO_COPY_HEX_16(Func, 0xA) MACRO_COPY_HEX_16(Func, 0xB) \
+	MACRO_COPY_HEX_16(Func, 0xC) MACRO_COPY_HEX_16(Func, 0xD) MACRO_COPY_HEX_16(Func, 0xE) MACRO_COPY_HEX_16(Func, 0xF)
+
 
 ////////////////////////////////////////////////////////////
 //						proc definition
@@ -303,18 +319,20 @@ enum ProcEnum : Uint8
 /**
  * Core function in script engine used to executing scripts
  * @param proc array storing operation of script
+ * @param ops counter of executed operations, only updated when Profile is set
  * @return Result of executing script
  */
-static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
+template<bool Profile>
+static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc, Uint64& ops)
 {
 	ProgPos curr = ProgPos::Start;
 	//--------------------------------------------------
 	//			helper macros for this function
 	//--------------------------------------------------
 	#define MACRO_FUNC_ARRAY(NAME, ...) + helper::FuncGroup<MACRO_FUNC_ID(NAME)>::FuncList{}
-	#define MACRO_FUNC_ARRAY_LOOP(POS) \
-		case (POS): \
+	#define MACRO_FUNC_ARRAY_IMPL(POS, NEXT) \
 		{ \
+			if (Profile) ++ops; \
 			using currType = helper::GetType<func, POS>; \
 			const auto p = proc + (int)curr; \
 			curr += currType::offset; \
@@ -330,12 +348,31 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 				} \
 			} \
 			else \
-				continue; \
+				NEXT; \
 		}
 	//--------------------------------------------------
 
 	using func = decltype(MACRO_PROC_DEFINITION(MACRO_FUNC_ARRAY));
 
+#ifdef __GNUC__
+	// every operation jumps directly to next one, this avoid range check of `switch`
+	// and give CPU separate branch prediction for each operation
+	#define MACRO_FUNC_ARRAY_LABEL(POS) &&op_##POS,
+	#define MACRO_FUNC_ARRAY_LOOP(POS) op_##POS: MACRO_FUNC_ARRAY_IMPL(POS, goto *jumpTable[proc[(int)curr++]])
+
+	static const void* const jumpTable[256] =
+	{
+		MACRO_COPY_HEX_256(MACRO_FUNC_ARRAY_LABEL)
+	};
+
+	goto *jumpTable[proc[(int)curr++]];
+
+	MACRO_COPY_HEX_256(MACRO_FUNC_ARRAY_LOOP)
+
+	#undef MACRO_FUNC_ARRAY_LABEL
+#else
+	#define MACRO_FUNC_ARRAY_LOOP(POS) case (POS): MACRO_FUNC_ARRAY_IMPL(POS, continue)
+
 	while (true)
 	{
 		switch (proc[(int)curr++])
@@ -343,11 +380,13 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 		MACRO_COPY_256(MACRO_FUNC_ARRAY_LOOP, 0)
 		}
 	}
+#endif
 
 	//--------------------------------------------------
 	//			removing helper macros
 	//--------------------------------------------------
 	#undef MACRO_FUNC_ARRAY_LOOP
+	#undef MACRO_FUNC_ARRAY_IMPL
 	#undef MACRO_FUNC_ARRAY
 	//--------------------------------------------------
 
@@ -363,6 +402,53 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 }
 
 
+////////////////////////////////////////////////////////////
+//					script profiling
+////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * Execution statistics of one parsed script.
+ */
+struct ScriptProfileData
+{
+	std::string hook;
+	std::string mod;
+	std::string script;
+	Uint64 calls;
+	Uint64 ops;
+	std::chrono::steady_clock::duration time;
+};
+
+/**
+ * Statistics of all parsed scripts, indexed by its proc data.
+ * Scripts are parsed during mod loading and run only by main thread, so no locking is needed.
+ */
+std::unordered_map<const Uint8*, ScriptProfileData> scriptProfiles;
+
+/**
+ * Store names used in report for newly parsed script.
+ */
+void addScriptProfile(const Uint8* proc, const std::string& hook, const std::string& mod, const std::string& script)
+{
+	scriptProfiles[proc] = ScriptProfileData{ hook, mod, script, 0, 0, std::chrono::steady_clock::duration::zero() };
+}
+
+/**
+ * Add results of one run of script.
+ */
+void updateScriptProfile(const Uint8* proc, Uint64 ops, std::chrono::steady_clock::time_point start)
+{
+	auto& data = scriptProfiles[proc];
+	data.calls += 1;
+	data.ops += ops;
+	data.time += std::chrono::steady_clock::now() - start;
+}
+
+} //namespace
+
 ////////////////////////////////////////////////////////////
 //						Script class
 ////////////////////////////////////////////////////////////
@@ -379,73 +465,99 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
  * @param y y offset of source surface.
  */
 void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, int shade, GraphSubset mask)
+{
+	if (_proc)
+	{
+		Uint64 ops = 0;
+		if (Options::scriptProfiler)
+		{
+			// whole blit is one call, global events run for each pixel are counted to main script
+			auto start = std::chrono::steady_clock::now();
+			executeBlitImpl<true>(src, dest, x, y, mask, ops);
+			updateScriptProfile(_proc, ops, start);
+		}
+		else
+		{
+			executeBlitImpl<false>(src, dest, x, y, mask, ops);
+		}
+	}
+	else
+	{
+		ShaderMove<Uint8> srcShader(src, x, y);
+		ShaderMove<Uint8> destShader(dest, 0, 0);
+
+		destShader.setDomain(mask);
+
+		ShaderDraw<helper::StandardShade>(destShader, srcShader, ShaderScalar(shade));
+	}
+}
+
+/**
+ * Bliting one surface to another using current script.
+ * @param ops counter of executed operations.
+ */
+template<bool Profile>
+void ScriptWorkerBlit::executeBlitImpl(Surface* src, Surface* dest, int x, int y, GraphSubset mask, Uint64& ops)
 {
 	ShaderMove<Uint8> srcShader(src, x, y);
 	ShaderMove<Uint8> destShader(dest, 0, 0);
 
 	destShader.setDomain(mask);
 
-	if (_proc)
+	if (_events)
 	{
-		if (_events)
-		{
-			ShaderDrawFunc(
-				[&](Uint8& dest, const Uint8& src)
+		ShaderDrawFunc(
+			[&](Uint8& dest, const Uint8& src)
+			{
+				if (src)
 				{
-					if (src)
+					ScriptWorkerBlit::Output arg = { src, dest };
+					set(arg);
+					auto ptr = _events;
+					while (*ptr)
 					{
-						ScriptWorkerBlit::Output arg = { src, dest };
-						set(arg);
-						auto ptr = _events;
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
 						reset(arg);
-						scriptExe(*this, _proc);
-
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
+						scriptExe<Profile>(*this, ptr->data(), ops);
 						++ptr;
-
-						get(arg);
-						if (arg.getFirst()) dest = arg.getFirst();
 					}
-				},
-				destShader,
-				srcShader
-			);
-		}
-		else
-		{
-			ShaderDrawFunc(
-				[&](Uint8& dest, const Uint8& src)
-				{
-					if (src)
+					++ptr;
+
+					reset(arg);
+					scriptExe<Profile>(*this, _proc, ops);
+
+					while (*ptr)
 					{
-						ScriptWorkerBlit::Output arg = { src, dest };
-						set(arg);
-						scriptExe(*this, _proc);
-						get(arg);
-						if (arg.getFirst()) dest = arg.getFirst();
+						reset(arg);
+						scriptExe<Profile>(*this, ptr->data(), ops);
+						++ptr;
 					}
-				},
-				destShader,
-				srcShader
-			);
-		}
+					++ptr;
+
+					get(arg);
+					if (arg.getFirst()) dest = arg.getFirst();
+				}
+			},
+			destShader,
+			srcShader
+		);
 	}
 	else
 	{
-		ShaderDraw<helper::StandardShade>(destShader, srcShader, ShaderScalar(shade));
+		ShaderDrawFunc(
+			[&](Uint8& dest, const Uint8& src)
+			{
+				if (src)
+				{
+					ScriptWorkerBlit::Output arg = { src, dest };
+					set(arg);
+					scriptExe<Profile>(*this, _proc, ops);
+					get(arg);
+					if (arg.getFirst()) dest = arg.getFirst();
+				}
+			},
+			destShader,
+			srcShader
+		);
 	}
 }
 
@@ -457,7 +569,63 @@ void ScriptWorkerBase::executeBase(const Uint8* proc)
 {
 	if (proc)
 	{
-		scriptExe(*this, proc);
+		Uint64 ops = 0;
+		if (Options::scriptProfiler)
+		{
+			auto start = std::chrono::steady_clock::now();
+			scriptExe<true>(*this, proc, ops);
+			updateScriptProfile(proc, ops, start);
+		}
+		else
+		{
+			scriptExe<false>(*this, proc, ops);
+		}
+	}
+}
+
+/**
+ * Write execution statistics of scripts to log, most expensive first, and reset them.
+ * Scripts with same hook, mod and name (like global events) are reported together.
+ */
+void ScriptWorkerBase::logProfile()
+{
+	std::map<std::tuple<std::string, std::string, std::string>, ScriptProfileData> merged;
+	auto total = std::chrono::steady_clock::duration::zero();
+	for (auto& p : scriptProfiles)
+	{
+		auto& data = p.second;
+		if (data.calls)
+		{
+			auto& m = merged[std::make_tuple(data.hook, data.mod, data.script)];
+			m.hook = data.hook;
+			m.mod = data.mod;
+			m.script = data.script;
+			m.calls += data.calls;
+			m.ops += data.ops;
+			m.time += data.time;
+			total += data.time;
+			data.calls = 0;
+			data.ops = 0;
+			data.time = std::chrono::steady_clock::duration::zero();
+		}
+	}
+
+	std::vector<const ScriptProfileData*> sorted;
+	for (auto& m : merged)
+	{
+		sorted.push_back(&m.second);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const ScriptProfileData* a, const ScriptProfileData* b) { return a->time > b->time; });
+
+	using ms = std::chrono::duration<double, std::milli>;
+	using us = std::chrono::duration<double, std::micro>;
+	Logger log;
+	log.get(LOG_INFO) << "Script profile: " << sorted.size() << " scripts, " << std::fixed << std::setprecision(2) << ms(total).count() << " ms total\n" << std::left;
+	log.get(LOG_INFO) << std::setw(12) << "Time [ms]" << std::setw(12) << "Calls" << std::setw(14) << "Operations" << std::setw(12) << "Avg [us]" << "Hook / Mod / Script\n";
+	for (auto d : sorted)
+	{
+		log.get(LOG_INFO) << std::setw(12) << ms(d->time).count() << std::setw(12) << d->calls << std::setw(14) << d->ops << std::setw(12) << us(d->time).count() / d->calls
+			<< d->hook << " / " << (d->mod.empty() ? "-" : d->mod) << " / " << d->script << "\n";
 	}
 }
 
@@ -848,15 +1016,133 @@ bool parseFullConditionImpl(ParserWriter& ph, ScriptRefData falsePos, const Scri
 	return true;
 }
 
+/**
+ * Get value of condition if all arguments are known at parse time.
+ * @return 1 if always true, 0 if always false, -1 if need be checked at runtime.
+ */
+int constConditionImpl(const ScriptRefData* begin, const ScriptRefData* end)
+{
+	if (std::distance(begin, end) != 3)
+	{
+		return -1;
+	}
+	auto isConst = [](const ScriptRefData& r)
+	{
+		return r.type == ArgInt && r.isValueType<int>();
+	};
+	if (!isConst(begin[1]) || !isConst(begin[2]))
+	{
+		return -1;
+	}
+
+	const int a = begin[1].getValue<int>();
+	const int b = begin[2].getValue<int>();
+	for (size_t i = 0; i < ConditionSize; ++i)
+	{
+		if (begin[0].name == ConditionNames[i])
+		{
+			bool result = i < 2 ? a == b : (i < 4 ? a <= b : b <= a);
+			return (i & 1) ? !result : result;
+		}
+	}
+	return -1;
+}
+
+/**
+ * Get value of `or` or `and` conditions if it is known at parse time.
+ * @return 1 if always true, 0 if always false, -1 if need be checked at runtime.
+ */
+int constFullConditionImpl(const ScriptRefData* begin, const ScriptRefData* end)
+{
+	if (std::distance(begin, end) <= 1)
+	{
+		return -1;
+	}
+	const auto orFunc = begin[0].name == ConditionSpecNames[0];
+	const auto andFunc = begin[0].name == ConditionSpecNames[1];
+	if (orFunc || andFunc)
+	{
+		++begin;
+		if (std::distance(begin, end) % 3 != 0)
+		{
+			return -1;
+		}
+		// `or` is decided by any true part, `and` by any false one.
+		const int decisive = orFunc ? 1 : 0;
+		int result = !decisive;
+		for (; begin != end; begin += 3)
+		{
+			int curr = constConditionImpl(begin, begin + 3);
+			if (curr == decisive)
+			{
+				return decisive;
+			}
+			if (curr == -1)
+			{
+				result = -1;
+			}
+		}
+		return result;
+	}
+	return constConditionImpl(begin, end);
+}
+
+/**
+ * Check all parts of condition like normal parsing do, without leaving any code behind.
+ * Constant part decide result but rest still need be valid, `if or eq 1 1 bogus x y;` is parse error.
+ */
+bool validateFullConditionImpl(ParserWriter& ph, const ScriptRefData* begin, const ScriptRefData* end)
+{
+	const auto pos = ph.getCurrPos();
+	const auto labels = ph.refLabelsList.size();
+	const auto emitted = ph.procEmitted;
+	const auto falsePos = ph.addLabel();
+	const bool valid = parseFullConditionImpl(ph, falsePos, begin, end);
+	// both exits point to end, if removing fails the code is only dead test.
+	ph.setLabel(falsePos, ph.getCurrPos());
+	if (ph.removeCodeTry(pos))
+	{
+		ph.refLabelsList.resize(labels);
+		ph.procEmitted = emitted;
+	}
+	return valid;
+}
+
+/**
+ * Parse condition of `if` or `else`, skipping it when result is known at parse time.
+ */
+bool parseBlockConditionImpl(ParserWriter& ph, ParserWriter::Block& block, const ScriptRefData* begin, const ScriptRefData* end)
+{
+	const int value = constFullConditionImpl(begin, end);
+	if (value != -1 && !validateFullConditionImpl(ph, begin, end))
+	{
+		return false;
+	}
+	if (value == 1)
+	{
+		// branch always taken, all next `else` are unreachable.
+		block.alwaysTaken = true;
+		return true;
+	}
+	else if (value == 0)
+	{
+		// branch never taken, jump stay only if removing of its code fail.
+		block.deadCode = ph.getCurrPos();
+		ph.pushProc(Proc_goto);
+		return ph.pushLabelTry(block.nextLabel);
+	}
+	return parseFullConditionImpl(ph, block.nextLabel, begin, end);
+}
+
 /**
  * Parser of `if` operation.
  */
 bool parseIf(const ScriptProcData& spd, ParserWriter& ph, const ScriptRefData* begin, const ScriptRefData* end)
 {
-	ParserWriter::Block block = { BlockIf, ph.addLabel(), ph.addLabel() };
+	ParserWriter::Block block = { BlockIf, ph.addLabel(), ph.addLabel(), ProgPos::Unknown, false };
 	ph.codeBlocks.push_back(block);
 
-	return parseFullConditionImpl(ph, block.nextLabel, begin, end);
+	return parseBlockConditionImpl(ph, ph.codeBlocks.back(), begin, end);
 }
 
 /**
@@ -872,8 +1158,14 @@ bool parseElse(const ScriptProcData& spd, ParserWriter& ph, const ScriptRefData*
 
 	ParserWriter::Block& block = ph.codeBlocks.back();
 
-	ph.pushProc(Proc_goto);
-	ph.pushLabelTry(block.finalLabel);
+	// when previous branch was removed there is nothing to jump over.
+	const bool removed = block.deadCode != ProgPos::Unknown && ph.removeCodeTry(block.deadCode);
+	block.deadCode = block.alwaysTaken ? ph.getCurrPos() : ProgPos::Unknown;
+	if (!removed)
+	{
+		ph.pushProc(Proc_goto);
+		ph.pushLabelTry(block.finalLabel);
+	}
 
 	ph.setLabel(block.nextLabel, ph.getCurrPos());
 	if (std::distance(begin, end) == 0)
@@ -885,7 +1177,12 @@ bool parseElse(const ScriptProcData& spd, ParserWriter& ph, const ScriptRefData*
 	else
 	{
 		block.nextLabel = ph.addLabel();
-		return parseFullConditionImpl(ph, block.nextLabel, begin, end);
+		if (block.alwaysTaken)
+		{
+			// unreachable, parsed only to validate it.
+			return parseFullConditionImpl(ph, block.nextLabel, begin, end);
+		}
+		return parseBlockConditionImpl(ph, block, begin, end);
 	}
 }
 
@@ -908,6 +1205,10 @@ bool parseEnd(const ScriptProcData& spd, ParserWriter& ph, const ScriptRefData*
 	ParserWriter::Block block = ph.codeBlocks.back();
 	ph.codeBlocks.pop_back();
 
+	if (block.deadCode != ProgPos::Unknown)
+	{
+		ph.removeCodeTry(block.deadCode);
+	}
 	if (block.nextLabel.getValue<int>() != block.finalLabel.getValue<int>())
 	{
 		ph.setLabel(block.nextLabel, ph.getCurrPos());
@@ -1563,6 +1864,8 @@ ParserWriter::ParserWriter(
 	refListCurr(),
 	refLabelsUses(),
 	refLabelsList(),
+	procList(),
+	procEmitted(0),
 	regIndexUsed(regUsed),
 	constIndexUsed(-1)
 {
@@ -1676,6 +1979,8 @@ ParserWriter::ReservedPos<ParserWriter::ProcOp> ParserWriter::pushProc(Uint8 pro
 {
 	auto curr = getCurrPos();
 	container._proc.push_back(procId);
+	procList.push_back(curr);
+	++procEmitted;
 	return { curr };
 }
 
@@ -1753,6 +2058,45 @@ bool ParserWriter::setLabel(const ScriptRefData& data, ProgPos offset)
 	return true;
 }
 
+/**
+ * Try removing unreachable code from proc vector.
+ * Fail if any label used by code before or a user label is pointing inside removed code.
+ * @param offset start of unreachable code.
+ * @return true if code was removed.
+ */
+bool ParserWriter::removeCodeTry(ProgPos offset)
+{
+	auto inside = [&](ProgPos pos)
+	{
+		return pos != ProgPos::Unknown && pos > offset;
+	};
+	for (auto& p : refLabelsUses)
+	{
+		if (p.first.getPos() < offset && inside(refLabelsList[p.second]))
+		{
+			return false;
+		}
+	}
+	for (auto& r : refListCurr)
+	{
+		if (r.type == ArgLabel && r.getValue<int>() >= 0 && inside(refLabelsList[r.getValue<int>()]))
+		{
+			return false;
+		}
+	}
+
+	refLabelsUses.erase(
+		std::remove_if(refLabelsUses.begin(), refLabelsUses.end(), [&](std::pair<ReservedPos<ProgPos>, int>& p) { return p.first.getPos() >= offset; }),
+		refLabelsUses.end()
+	);
+	while (!procList.empty() && procList.back() >= offset)
+	{
+		procList.pop_back();
+	}
+	container._proc.resize(static_cast<size_t>(offset));
+	return true;
+}
+
 /**
  * Try pushing data arg on proc vector.
  * @param s name of data
@@ -2200,6 +2544,8 @@ bool ScriptParserBase::parseBase(ScriptContainerBase& destScript, const std::str
 				Log(LOG_ERROR) << err << "script need to end with return statement";
 			}
 			help.relese();
+			Log(LOG_VERBOSE) << "Script '" << _name << "' for '" << parentName << "': " << help.procList.size() << " operations (" << help.procEmitted << " before removing unreachable code)";
+			addScriptProfile(tempScript.data(), _name, _shared->getCurrentModName(), parentName);
 			destScript = std::move(tempScript);
 			return true;
 		}
@@ -2488,6 +2834,13 @@ ScriptParserEventsBase::ScriptParserEventsBase(ScriptGlobal* shared, const std::
  */
 void ScriptParserEventsBase::parseNode(ScriptContainerEventsBase& container, const std::string& type, const YAML::Node& node) const
 {
+	if (const YAML::Node& scripts = node["scripts"])
+	{
+		if (scripts[getName()])
+		{
+			container._custom = true;
+		}
+	}
 	ScriptParserBase::parseNode(container._current, type, node);
 	container._events = getEvents();
 }
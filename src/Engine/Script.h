@@ -309,7 +309,8 @@ class ScriptContainerEventsBase
 {
 	friend class ScriptParserEventsBase;
 	ScriptContainerBase _current;
-	const ScriptContainerBase* _events;
+	const ScriptContainerBase* _events = nullptr;
+	bool _custom = false;
 
 public:
 	/// Test if is any script there.
@@ -318,6 +319,13 @@ public:
 		return true;
 	}
 
+	/// Test if only default script of parser is run, without any global events.
+	bool isDefault() const
+	{
+		// events are stored as two lists each ended by empty script
+		return !_custom && (!_events || (!_events[0] && !_events[1]));
+	}
+
 	/// Get pointer to proc data.
 	const Uint8* data() const
 	{
@@ -569,6 +577,9 @@ public:
 	void log_buffer_add(const std::string& s);
 	/// Flush buffer to log file.
 	void log_buffer_flush(ProgPos& p);
+
+	/// Write execution statistics of scripts to log and reset them.
+	static void logProfile();
 };
 
 /**
@@ -646,6 +657,10 @@ class ScriptWorkerBlit : public ScriptWorkerBase
 	const Uint8* _proc;
 	const ScriptContainerBase* _events;
 
+	/// Bliting using script, Profile select version that count executed operations.
+	template<bool Profile>
+	void executeBlitImpl(Surface* src, Surface* dest, int x, int y, GraphSubset mask, Uint64& ops);
+
 public:
 	/// Type of output value from script.
 	using Output = ScriptOutputArgs<int&, int>;
@@ -1429,6 +1444,11 @@ protected:
 		static_assert(std::is_base_of<ScriptGlobal, ThisType>::value, "Type must be derived");
 		addTagValueTypeBase(name, &loadHelper<ThisType, LoadValue>, &saveHelper<ThisType, SaveValue>);
 	}
+	/// Set name of mod that next parsed scripts belong to.
+	void setCurrentModName(const std::string& name)
+	{
+		_currentModName = name;
+	}
 private:
 	std::vector<std::vector<char>> _strings;
 	std::vector<std::vector<ScriptContainerBase>> _events;
@@ -1437,6 +1457,7 @@ private:
 	std::map<ArgEnum, TagData> _tagNames;
 	std::vector<TagValueType> _tagValueTypes;
 	std::vector<ScriptRefData> _refList;
+	std::string _currentModName;
 
 	/// Get tag value.
 	size_t getTag(ArgEnum type, ScriptRef s) const;
@@ -1469,6 +1490,8 @@ public:
 
 	/// Get global ref data.
 	const ScriptRefData* getRef(ScriptRef name, ScriptRef postfix = {}) const;
+	/// Get name of mod that currently parsed scripts belong to.
+	const std::string& getCurrentModName() const { return _currentModName; }
 
 	/// Get tag based on it name.
 	template<typename Tag>
@@ -48,6 +48,10 @@ struct ParserWriter
 		BlockEnum type;
 		ScriptRefData nextLabel;
 		ScriptRefData finalLabel;
+		/// start of code that can't be reached because of constant condition.
+		ProgPos deadCode;
+		/// some branch of this block was always taken.
+		bool alwaysTaken;
 	};
 
 	template<typename T, typename = typename std::enable_if<std::is_pod<T>::value>::type>
@@ -78,6 +82,10 @@ struct ParserWriter
 	std::vector<std::pair<ReservedPos<ProgPos>, int>> refLabelsUses;
 	/// list of labels positions.
 	std::vector<ProgPos> refLabelsList;
+	/// list of positions of all operations in proc vector.
+	std::vector<ProgPos> procList;
+	/// number of all operations emitted, including removed ones.
+	int procEmitted;
 
 	/// index of used script registers.
 	Uint8 regIndexUsed;
@@ -142,6 +150,9 @@ struct ParserWriter
 	/// Setting offset of label on proc vector.
 	bool setLabel(const ScriptRefData& data, ProgPos offset);
 
+	/// Try removing unreachable code from given position to end of proc vector.
+	bool removeCodeTry(ProgPos offset);
+
 	/// Try pushing reg arg on proc vector.
 	template<typename T>
 	bool pushConstTry(const ScriptRefData& data)
@@ -20,10 +20,56 @@
 #include "ShaderDrawHelper.h"
 #include "HelperMeta.h"
 #include <tuple>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace OpenXcom
 {
 
+namespace helper
+{
+
+/**
+ * Wrapper of `ColorFunc::func` that keep type of `ColorFunc` for selecting specialized row loops.
+ */
+template<typename ColorFunc>
+struct StaticFunc
+{
+	template<typename... T>
+	inline void operator()(T&&... t) const
+	{
+		ColorFunc::func(std::forward<T>(t)...);
+	}
+};
+
+/**
+ * Loop drawing one row of pixels, one pixel at once.
+ */
+template<typename Func, typename... SrcType>
+static inline void ShaderDrawRowLoop(Func& f, int size, controler<SrcType>&... src)
+{
+	for (int x = size; x>0; --x, (void)helper::DummySeq{ (src.inc_x(), 0)... })
+	{
+		f(src.get_ref()...);
+	}
+}
+
+/**
+ * Loop drawing one row of pixels, can be specialized for `Func` to process multiple pixels at once.
+ */
+template<typename Func>
+struct ShaderDrawRow
+{
+	template<typename F, typename... SrcType>
+	static inline void row(F& f, int size, controler<SrcType>&... src)
+	{
+		ShaderDrawRowLoop(f, size, src...);
+	}
+};
+
+}//namespace helper
+
 /**
  * Universal blit function implementation.
  * @param f called function.
@@ -83,10 +129,7 @@ static inline void ShaderDrawImpl(Func&& f, helper::controler<SrcType>... src)
 		};
 
 		//iteration on x-axis
-		for (int x = end_x-begin_x; x>0; --x, (void)helper::DummySeq{ (src.inc_x(), 0)... })
-		{
-			f(src.get_ref()...);
-		}
+		helper::ShaderDrawRow<typename std::decay<Func>::type>::row(f, end_x-begin_x, src...);
 	}
 
 };
@@ -100,7 +143,7 @@ static inline void ShaderDrawImpl(Func&& f, helper::controler<SrcType>... src)
 template<typename ColorFunc, typename... SrcType>
 static inline void ShaderDraw(const SrcType&... src_frame)
 {
-	ShaderDrawImpl(ColorFunc::func, helper::controler<SrcType>(src_frame)...);
+	ShaderDrawImpl(helper::StaticFunc<ColorFunc>{}, helper::controler<SrcType>(src_frame)...);
 }
 
 /**
@@ -209,6 +252,101 @@ struct BurnShade
 	}
 };
 
+#ifdef __SSE2__
+
+/**
+ * Shade 16 pixels at once, same as `StandardShade::func` or `ColorReplace::func` for shade in range 0 to 15.
+ * @param dest destination pixels
+ * @param src source pixels
+ * @param shade shade in every byte
+ * @param group color group in every byte, or zero to keep group of source pixel.
+ * @param keepGroup all bits set to keep group of source pixel.
+ */
+static inline void ShadeSSE2(Uint8* dest, const Uint8* src, __m128i shade, __m128i group, __m128i keepGroup)
+{
+	const __m128i colorShade = _mm_set1_epi8(ColorShade);
+	const __m128i colorGroup = _mm_set1_epi8((char)ColorGroup);
+
+	const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest));
+	const __m128i transparent = _mm_cmpeq_epi8(s, _mm_setzero_si128());
+
+	const __m128i newShade = _mm_add_epi8(_mm_and_si128(s, colorShade), shade);
+	const __m128i tooDark = _mm_cmpgt_epi8(newShade, colorShade);
+	const __m128i newGroup = _mm_or_si128(_mm_and_si128(keepGroup, _mm_and_si128(s, colorGroup)), group);
+	const __m128i color = _mm_or_si128(
+		_mm_and_si128(tooDark, colorShade),
+		_mm_andnot_si128(tooDark, _mm_or_si128(newGroup, newShade))
+	);
+	const __m128i result = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, color));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dest), result);
+}
+
+/**
+ * Row loop for `StandardShade` using SSE2 for 16 pixels at once.
+ */
+template<>
+struct ShaderDrawRow<StaticFunc<StandardShade>>
+{
+	template<typename F, typename... SrcType>
+	static inline void row(F& f, int size, controler<SrcType>&... src)
+	{
+		ShaderDrawRowLoop(f, size, src...);
+	}
+
+	template<typename F, typename DestType, typename SrcType, typename ShadeType>
+	static inline void row(F& f, int size, controler<DestType>& dest, controler<SrcType>& src, controler<Scalar<ShadeType>>& shade)
+	{
+		const int s = shade.get_ref();
+		if (s >= 0 && s <= ColorShade && dest.step.first == 1 && src.step.first == 1)
+		{
+			const __m128i shadeVec = _mm_set1_epi8((char)s);
+			const __m128i keepGroup = _mm_set1_epi8((char)0xFF);
+			for (; size >= 16; size -= 16)
+			{
+				ShadeSSE2(&dest.get_ref(), &src.get_ref(), shadeVec, _mm_setzero_si128(), keepGroup);
+				dest.ptr_pos_x += 16;
+				src.ptr_pos_x += 16;
+			}
+		}
+		ShaderDrawRowLoop(f, size, dest, src, shade);
+	}
+};
+
+/**
+ * Row loop for `ColorReplace` using SSE2 for 16 pixels at once.
+ */
+template<>
+struct ShaderDrawRow<StaticFunc<ColorReplace>>
+{
+	template<typename F, typename... SrcType>
+	static inline void row(F& f, int size, controler<SrcType>&... src)
+	{
+		ShaderDrawRowLoop(f, size, src...);
+	}
+
+	template<typename F, typename DestType, typename SrcType, typename ShadeType, typename ColorType>
+	static inline void row(F& f, int size, controler<DestType>& dest, controler<SrcType>& src, controler<Scalar<ShadeType>>& shade, controler<Scalar<ColorType>>& newColor)
+	{
+		const int s = shade.get_ref();
+		const int c = newColor.get_ref();
+		if (s >= 0 && s <= ColorShade && (c & ~ColorGroup) == 0 && dest.step.first == 1 && src.step.first == 1)
+		{
+			const __m128i shadeVec = _mm_set1_epi8((char)s);
+			const __m128i groupVec = _mm_set1_epi8((char)c);
+			for (; size >= 16; size -= 16)
+			{
+				ShadeSSE2(&dest.get_ref(), &src.get_ref(), shadeVec, groupVec, _mm_setzero_si128());
+				dest.ptr_pos_x += 16;
+				src.ptr_pos_x += 16;
+			}
+		}
+		ShaderDrawRowLoop(f, size, dest, src, shade, newColor);
+	}
+};
+
+#endif
+
 }//namespace helper
 
 template<typename T>
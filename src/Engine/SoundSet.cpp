@@ -21,6 +21,8 @@
 #include "Sound.h"
 #include "Exception.h"
 #include <sstream>
+#include <vector>
+#include <string.h>
 namespace OpenXcom
 {
 
@@ -41,130 +43,257 @@ SoundSet::~SoundSet()
 	{
 		delete i->second;
 	}
+	for (std::map<std::string, CatOpen>::iterator i = _catFiles.begin(); i != _catFiles.end(); ++i)
+	{
+		delete i->second.file;
+	}
 }
 
 /**
- * Loads the contents of an X-Com CAT file which usually contains
- * a set of sound files. The CAT starts with an index of the offset
- * and size of every file contained within. Each file consists of a
- * filename followed by its contents.
+ * Opens a CAT file and keeps it in memory until all sounds
+ * taken from it are decoded, they are decoded when first used.
  * @param filename Filename of the CAT set.
- * @param wav Are the sounds in WAV format?
- * @sa http://www.ufopaedia.org/index.php?title=SOUND
+ * @return Pointer to the file.
  */
-void SoundSet::loadCat(const std::string &filename, bool wav)
+const CatFile *SoundSet::openCat(const std::string &filename)
 {
-	// Load CAT file
-	CatFile sndFile (filename.c_str());
-	if (!sndFile)
+	std::map<std::string, CatOpen>::iterator i = _catFiles.find(filename);
+	if (i != _catFiles.end())
+	{
+		return i->second.file;
+	}
+	CatFile *file = new CatFile(filename.c_str());
+	if (!(*file))
 	{
+		delete file;
 		throw Exception(filename + " not found");
 	}
+	CatOpen open = { file, 0 };
+	_catFiles[filename] = open;
+	return file;
+}
 
-	// Load each sound file
-	for (int i = 0; i < sndFile.getAmount(); ++i)
+/**
+ * Sets a sound to be decoded from a CAT file,
+ * replacing any sound with the same number.
+ * @param i Sound number in the set.
+ * @param entry Where the sound is stored.
+ */
+void SoundSet::setCatSound(int i, const CatSound &entry)
+{
+	for (std::map<std::string, CatOpen>::iterator f = _catFiles.begin(); f != _catFiles.end(); ++f)
 	{
-		// Read WAV chunk
-		unsigned char *sound = (unsigned char*) sndFile.load(i);
-		unsigned int size = sndFile.getObjectSize(i);
+		if (f->second.file == entry.file)
+		{
+			++f->second.pending;
+			break;
+		}
+	}
+	// counted first, the old sound can be from the same file
+	std::map<int, CatSound>::iterator old = _catSounds.find(i);
+	if (old != _catSounds.end())
+	{
+		eraseCatSound(old);
+	}
+	_catSounds[i] = entry;
+}
 
-		// If there's no WAV header (44 bytes), add it
-		// Assuming sounds are 8-bit 8000Hz (DOS version)
-		unsigned char *newsound = 0;
-		if (!wav)
+/**
+ * Removes a sound of a CAT file,
+ * the file is closed when no other sound is pending on it.
+ * @param entry Sound to remove.
+ */
+void SoundSet::eraseCatSound(std::map<int, CatSound>::iterator entry)
+{
+	for (std::map<std::string, CatOpen>::iterator f = _catFiles.begin(); f != _catFiles.end(); ++f)
+	{
+		if (f->second.file == entry->second.file)
 		{
-			if (size != 0)
+			if (--f->second.pending == 0)
 			{
-				char header[] = {'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ',
-								 0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00,
-								 'd', 'a', 't', 'a', 0x00, 0x00, 0x00, 0x00};
-
-				for (unsigned int n = 0; n < size; ++n) sound[n] *= 4; // scale to 8 bits
-				if (size > 5) size -= 5; // skip 5 garbage name bytes at beginning
-				if (size) size--; // omit trailing null byte
-
-				newsound = new unsigned char[44 + size*2];
-				memcpy(newsound, header, 44);
-				if (size) memcpy(newsound + 44, sound+5, size);
-				Uint32 step16 = (8000<<16)/11025;
-				Uint8 *w = newsound+44;
-				int newsize = 0;
-				for (Uint32 offset16 = 0; (offset16>>16) < size; offset16 += step16, ++w, ++newsize)
-				{
-					*w = sound[5 + (offset16>>16)];
-				}
-				size = newsize + 44;
-
-				int headersize = newsize + 36;
-				int soundsize = newsize;
-				memcpy(newsound + 4, &headersize, sizeof(headersize));
-				memcpy(newsound + 40, &soundsize, sizeof(soundsize));
+				delete f->second.file;
+				_catFiles.erase(f);
 			}
+			break;
 		}
-		else if (0x40 == sound[0x18] && 0x1F == sound[0x19] && 0x00 == sound[0x1A] && 0x00 == sound[0x1B])
+	}
+	_catSounds.erase(entry);
+}
+
+/**
+ * Loads the contents of an X-Com CAT file which usually contains
+ * a set of sound files. The CAT starts with an index of the offset
+ * and size of every file contained within. Each file consists of a
+ * filename followed by its contents.
+ * @param filename Filename of the CAT set.
+ * @param wav Are the sounds in WAV format?
+ * @sa http://www.ufopaedia.org/index.php?title=SOUND
+ */
+void SoundSet::loadCat(const std::string &filename, bool wav)
+{
+	const CatFile *sndFile = openCat(filename);
+
+	for (int i = 0; i < sndFile->getAmount(); ++i)
+	{
+		std::map<int, Sound*>::iterator old = _sounds.find(i);
+		if (old != _sounds.end())
 		{
-			// so it's WAV, but in 8 khz, we have to convert it to 11 khz sound
+			delete old->second;
+			_sounds.erase(old);
+		}
+		CatSound entry = { sndFile, (unsigned int)i, wav ? CAT_WAV : CAT_DOS };
+		setCatSound(i, entry);
+	}
+}
 
-			unsigned char *sound2 = new unsigned char[size*2];
+/**
+ * Decodes a sound stored in a CAT file.
+ * @param entry Where the sound is stored.
+ * @return Pointer to the new sound, empty if the data is junk.
+ */
+Sound *SoundSet::loadCatSound(const CatSound &entry)
+{
+	unsigned int size = 0;
+	const unsigned char *data = (const unsigned char*) entry.file->getObject(entry.index, &size);
+	std::vector<unsigned char> padded, converted;
 
-			// rewrite the samplerate in the header to 11 khz
-			sound[0x18]=0x11; sound[0x19]=0x2B; sound[0x1C]=0x11; sound[0x1D]=0x2B;
+	// the last sound of some files is cut short, fill up the missing bytes
+	if (data != 0 && size < entry.file->getObjectSize(entry.index))
+	{
+		padded.assign(data, data + size);
+		padded.resize(entry.file->getObjectSize(entry.index));
+		size = padded.size();
+		data = &padded[0];
+	}
 
-			// copy and do the conversion...
-			memcpy(sound2, sound, size);
+	if (entry.format == CAT_DOS)
+	{
+		// There's no WAV header (44 bytes), add it
+		// Assuming sounds are 8-bit 8000Hz (DOS version)
+		if (size != 0)
+		{
+			char header[] = {'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ',
+							 0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00,
+							 'd', 'a', 't', 'a', 0x00, 0x00, 0x00, 0x00};
+
+			std::vector<unsigned char> sound(data, data + size);
+			sound.resize(size + 5);
+			for (unsigned int n = 0; n < size; ++n) sound[n] *= 4; // scale to 8 bits
+			if (size > 5) size -= 5; // skip 5 garbage name bytes at beginning
+			if (size) size--; // omit trailing null byte
+
+			converted.resize(44 + size*2);
+			memcpy(&converted[0], header, 44);
 			Uint32 step16 = (8000<<16)/11025;
-			Uint8 *w = sound2+44;
+			Uint8 *w = &converted[44];
 			int newsize = 0;
-			for (Uint32 offset16 = 0; (offset16>>16) < size-44; offset16 += step16, ++w, ++newsize)
+			for (Uint32 offset16 = 0; (offset16>>16) < size; offset16 += step16, ++w, ++newsize)
 			{
-				*w = sound[44 + (offset16>>16)];
+				*w = sound[5 + (offset16>>16)];
 			}
 			size = newsize + 44;
 
-			// Rewrite the number of samples in the WAV file
-			memcpy(sound2 + 0x28, &newsize, sizeof(newsize));
-
-			// Ok, now replace the original with the converted:
-			delete[] sound;
-			sound = sound2;
+			int headersize = newsize + 36;
+			int soundsize = newsize;
+			memcpy(&converted[4], &headersize, sizeof(headersize));
+			memcpy(&converted[40], &soundsize, sizeof(soundsize));
+			data = &converted[0];
 		}
-
-		Sound *s = new Sound();
-		try
+	}
+	else if (entry.format == CAT_TFTD)
+	{
+		// there's no WAV header (44 bytes), add it
+		// sounds are 8-bit 11025Hz, signed
+		if (size != 0)
 		{
-			if (size == 0)
+			char header[] = {'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ',
+								0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00,
+								'd', 'a', 't', 'a', 0x00, 0x00, 0x00, 0x00};
+
+			std::vector<unsigned char> sound(data, data + size);
+			sound.resize(size + 5);
+			if (size > 5) size -= 5; // skip 5 garbage name bytes at beginning
+			if (size) size--; // omit trailing null byte
+
+			int headersize = size + 36;
+			int soundsize = size;
+			memcpy(header + 4, &headersize, sizeof(headersize));
+			memcpy(header + 40, &soundsize, sizeof(soundsize));
+
+			converted.resize(44 + size);
+			memcpy(&converted[0], header, 44);
+
+			// TFTD sounds are signed, so we need to convert them.
+			for (unsigned int n = 0; n < size; ++n)
 			{
-				throw Exception("Invalid sound file");
+				int value = (int)sound[5 + n] + 128;
+				converted[44 + n] = (uint8_t)value;
 			}
-			if (wav)
-				s->load(sound, size);
-			else
-				s->load(newsound, size);
+			size = size + 44;
+			data = &converted[0];
 		}
-		catch (Exception)
+	}
+	else if (size >= 44 && 0x40 == data[0x18] && 0x1F == data[0x19] && 0x00 == data[0x1A] && 0x00 == data[0x1B])
+	{
+		// so it's WAV, but in 8 khz, we have to convert it to 11 khz sound
+		converted.resize(size*2);
+
+		// copy and rewrite the samplerate in the header to 11 khz
+		memcpy(&converted[0], data, size);
+		converted[0x18]=0x11; converted[0x19]=0x2B; converted[0x1C]=0x11; converted[0x1D]=0x2B;
+
+		// do the conversion...
+		Uint32 step16 = (8000<<16)/11025;
+		Uint8 *w = &converted[44];
+		int newsize = 0;
+		for (Uint32 offset16 = 0; (offset16>>16) < size-44; offset16 += step16, ++w, ++newsize)
 		{
-			// Ignore junk in the file
+			*w = data[44 + (offset16>>16)];
 		}
-		_sounds[i] = s;
+		size = newsize + 44;
 
-		delete[] sound;
-		if (!wav)
+		// Rewrite the number of samples in the WAV file
+		memcpy(&converted[0x28], &newsize, sizeof(newsize));
+		data = &converted[0];
+	}
+	// other WAV files are read straight from the CAT file
+
+	Sound *s = new Sound();
+	try
+	{
+		if (size == 0)
 		{
-			delete[] newsound;
+			throw Exception("Invalid sound file");
 		}
+		s->load(data, size);
+	}
+	catch (Exception)
+	{
+		// Ignore junk in the file
 	}
+	return s;
 }
 
 /**
- * Returns a particular wave from the sound set.
+ * Returns a particular wave from the sound set,
+ * sounds of CAT files are decoded on first use.
  * @param i Sound number in the set.
  * @return Pointer to the respective sound.
  */
 Sound *SoundSet::getSound(unsigned int i)
 {
-	if (_sounds.find(i) != _sounds.end())
+	std::map<int, Sound*>::iterator sound = _sounds.find(i);
+	if (sound != _sounds.end())
+	{
+		return sound->second;
+	}
+	std::map<int, CatSound>::iterator entry = _catSounds.find(i);
+	if (entry != _catSounds.end())
 	{
-		return _sounds[i];
+		Sound *s = loadCatSound(entry->second);
+		eraseCatSound(entry);
+		_sounds[i] = s;
+		return s;
 	}
 	return 0;
 }
@@ -177,6 +306,11 @@ Sound *SoundSet::getSound(unsigned int i)
  */
 Sound *SoundSet::addSound(unsigned int i)
 {
+	std::map<int, CatSound>::iterator entry = _catSounds.find(i);
+	if (entry != _catSounds.end())
+	{
+		eraseCatSound(entry);
+	}
 	_sounds[i] = new Sound();
 	return _sounds[i];
 }
@@ -188,7 +322,7 @@ Sound *SoundSet::addSound(unsigned int i)
  */
 size_t SoundSet::getTotalSounds() const
 {
-	return _sounds.size();
+	return _sounds.size() + _catSounds.size();
 }
 
 /**
@@ -202,73 +336,16 @@ size_t SoundSet::getTotalSounds() const
  */
 void SoundSet::loadCatbyIndex(const std::string &filename, int index)
 {
-	// Load CAT file
-	CatFile sndFile (filename.c_str());
-	if (!sndFile)
-	{
-		throw Exception(filename + " not found");
-	}
-	if (index >= sndFile.getAmount())
+	const CatFile *sndFile = openCat(filename);
+	if (index >= sndFile->getAmount())
 	{
 		std::ostringstream err;
 		err << filename << " does not contain " << index << " sound files.";
 		throw Exception(err.str());
 	}
 
-	// Read WAV chunk
-	unsigned char *sound = (unsigned char*) sndFile.load(index);
-	unsigned int size = sndFile.getObjectSize(index);
-
-	// there's no WAV header (44 bytes), add it
-	// sounds are 8-bit 11025Hz, signed
-	unsigned char *newsound = 0;
-
-	if (size != 0)
-	{
-		char header[] = {'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ',
-							0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00,
-							'd', 'a', 't', 'a', 0x00, 0x00, 0x00, 0x00};
-
-
-		if (size > 5) size -= 5; // skip 5 garbage name bytes at beginning
-		if (size) size--; // omit trailing null byte
-
-		int headersize = size + 36;
-		int soundsize = size;
-		memcpy(header + 4, &headersize, sizeof(headersize));
-		memcpy(header + 40, &soundsize, sizeof(soundsize));
-
-		newsound = new unsigned char[44 + size];
-		memcpy(newsound, header, 44);
-
-		// TFTD sounds are signed, so we need to convert them.
-		for (unsigned int n = 5; n < size + 5; ++n)
-		{
-			int value = (int)sound[n] + 128;
-			sound[n] = (uint8_t)value;
-		}
-
-		if (size) memcpy(newsound + 44, sound+5, size);
-		size = size + 44;
-	}
-
-	Sound *s = new Sound();
-	try
-	{
-		if (size == 0)
-		{
-			throw Exception("Invalid sound file");
-		}
-		s->load(newsound, size);
-	}
-	catch (Exception)
-	{
-		// Ignore junk in the file
-	}
-	_sounds[getTotalSounds()] = s;
-
-	delete[] sound;
-	delete[] newsound;
+	CatSound entry = { sndFile, (unsigned int)index, CAT_TFTD };
+	setCatSound(getTotalSounds(), entry);
 }
 
 }
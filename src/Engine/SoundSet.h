@@ -24,6 +24,7 @@ namespace OpenXcom
 {
 
 class Sound;
+class CatFile;
 
 /**
  * Container of a set of sounds.
@@ -33,7 +34,32 @@ class Sound;
 class SoundSet
 {
 private:
+	/// Formats of sounds stored in CAT files.
+	enum CatFormat { CAT_WAV, CAT_DOS, CAT_TFTD };
+	/// Sound of a CAT file, decoded on first use.
+	struct CatSound
+	{
+		const CatFile *file;
+		unsigned int index;
+		CatFormat format;
+	};
+	/// CAT file kept open while some of its sounds are not decoded.
+	struct CatOpen
+	{
+		CatFile *file;
+		size_t pending;
+	};
 	std::map<int, Sound*> _sounds;
+	std::map<int, CatSound> _catSounds;
+	std::map<std::string, CatOpen> _catFiles;
+	/// Opens a CAT file, or gets it if it was already opened.
+	const CatFile *openCat(const std::string &filename);
+	/// Sets a sound to be decoded from a CAT file.
+	void setCatSound(int i, const CatSound &entry);
+	/// Removes a sound of a CAT file, closing the file when no other sound needs it.
+	void eraseCatSound(std::map<int, CatSound>::iterator entry);
+	/// Decodes a sound of a CAT file.
+	static Sound *loadCatSound(const CatSound &entry);
 public:
 	/// Crates a sound set.
 	SoundSet();
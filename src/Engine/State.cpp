@@ -36,6 +36,7 @@
 #include "../Interface/ComboBox.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Mod/RuleInterface.h"
 
@@ -248,6 +249,9 @@ void State::init()
 	_game->getFpsCounter()->setPalette(_palette);
 	_game->getFpsCounter()->setColor(_cursorColor);
 	_game->getFpsCounter()->draw();
+	_game->getProfilerOverlay()->setPalette(_palette);
+	_game->getProfilerOverlay()->setColor(_cursorColor);
+	_game->getProfilerOverlay()->draw();
 	if (_game->getMod() != 0)
 	{
 		_game->getMod()->setPalette(_palette);
@@ -466,6 +470,8 @@ void State::setPalette(SDL_Color *colors, int firstcolor, int ncolors, bool imme
 		_game->getCursor()->draw();
 		_game->getFpsCounter()->setPalette(_palette);
 		_game->getFpsCounter()->draw();
+		_game->getProfilerOverlay()->setPalette(_palette);
+		_game->getProfilerOverlay()->draw();
 		if (_game->getMod() != 0)
 		{
 			_game->getMod()->setPalette(_palette);
@@ -19,7 +19,9 @@
 #include "Surface.h"
 #include "ShaderDraw.h"
 #include <vector>
+#include <map>
 #include <fstream>
+#include <ctime>
 #include <SDL_gfxPrimitives.h>
 #include <SDL_image.h>
 #include <SDL_endian.h>
@@ -28,6 +30,7 @@
 #include "Exception.h"
 #include "Logger.h"
 #include "ShaderMove.h"
+#include "CrossPlatform.h"
 #include <stdlib.h>
 #ifdef _WIN32
 #include <malloc.h>
@@ -48,6 +51,28 @@ namespace OpenXcom
 namespace
 {
 
+/**
+ * Image decoded by loadImage, stored in image cache.
+ */
+struct ImageCacheEntry
+{
+	Uint64 size;
+	Sint64 modified;
+	Uint16 width, height;
+	Uint8 transparent;
+	std::vector<SDL_Color> palette;
+	std::vector<Uint8> pixels;
+	bool used;
+};
+
+/// Decoded images by file path, only used while loading mods.
+std::map<std::string, ImageCacheEntry> imageCache;
+bool imageCacheActive = false;
+bool imageCacheChanged = false;
+
+const char ImageCacheMagic[4] = { 'O', 'X', 'I', 'C' };
+const Uint32 ImageCacheVersion = 1;
+
 /**
  * Helper function counting pitch in bytes with 16byte padding
  * @param bpp bits per pixel
@@ -258,6 +283,35 @@ void Surface::loadImage(const std::string &filename)
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
 
+	// Reuse the pixels decoded by previous run if the file is unchanged
+	Uint64 fileSize = 0;
+	Sint64 fileModified = 0;
+	if (imageCacheActive)
+	{
+		fileSize = CrossPlatform::getFileSize(filename);
+		fileModified = CrossPlatform::getDateModified(filename);
+		std::map<std::string, ImageCacheEntry>::iterator cached = imageCache.find(filename);
+		if (cached != imageCache.end() && cached->second.size == fileSize && cached->second.modified == fileModified)
+		{
+			ImageCacheEntry &entry = cached->second;
+			_alignedBuffer = NewAligned(8, entry.width, entry.height);
+			_surface = SDL_CreateRGBSurfaceFrom(_alignedBuffer, entry.width, entry.height, 8, GetPitch(8, entry.width), 0, 0, 0, 0);
+			if (_surface)
+			{
+				for (int y = 0; y < entry.height; ++y)
+				{
+					memcpy((Uint8*)_surface->pixels + y * _surface->pitch, &entry.pixels[y * entry.width], entry.width);
+				}
+				setPalette(entry.palette.data(), 0, entry.palette.size());
+				SDL_SetColorKey(_surface, SDL_SRCCOLORKEY, entry.transparent);
+				entry.used = true;
+				return;
+			}
+			DeleteAligned(_alignedBuffer);
+			_alignedBuffer = 0;
+		}
+	}
+
 	// Try loading with LodePNG first
 	std::vector<unsigned char> png;
 	unsigned error = lodepng::load_file(png, filename);
@@ -295,6 +349,21 @@ void Surface::loadImage(const std::string &filename)
 						}
 					}
 					SDL_SetColorKey(_surface, SDL_SRCCOLORKEY, transparent);
+
+					// files changed in last seconds can change again without new timestamp
+					if (imageCacheActive && fileModified != 0 && fileModified + 1 < (Sint64)time(0) && width <= 0xFFFF && height <= 0xFFFF && image.size() == width * height)
+					{
+						ImageCacheEntry &entry = imageCache[filename];
+						entry.size = fileSize;
+						entry.modified = fileModified;
+						entry.width = width;
+						entry.height = height;
+						entry.transparent = transparent;
+						entry.palette.assign((SDL_Color*)color->palette, (SDL_Color*)color->palette + color->palettesize);
+						entry.pixels.swap(image);
+						entry.used = true;
+						imageCacheChanged = true;
+					}
 				}
 			}
 		}
@@ -316,6 +385,128 @@ void Surface::loadImage(const std::string &filename)
 	}
 }
 
+/**
+ * Reads images decoded by previous run, so loadImage can skip
+ * decoding PNG files that didn't change since.
+ * Whole file is read at once.
+ * @param filename Filename of the cache.
+ */
+void Surface::loadImageCache(const std::string &filename)
+{
+	imageCache.clear();
+	imageCacheActive = true;
+	imageCacheChanged = false;
+
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		return;
+	}
+	file.seekg(0, std::ios::end);
+	std::streamoff length = file.tellg();
+	file.seekg(0, std::ios::beg);
+	std::vector<char> data(length > 0 ? (size_t)length : 0);
+	if (data.empty() || !file.read(data.data(), data.size()))
+	{
+		return;
+	}
+
+	size_t pos = 0;
+	const auto read = [&](void *dest, size_t size)
+	{
+		if (data.size() - pos < size)
+		{
+			return false;
+		}
+		memcpy(dest, &data[pos], size);
+		pos += size;
+		return true;
+	};
+
+	char magic[sizeof(ImageCacheMagic)];
+	Uint32 version;
+	if (!read(magic, sizeof(magic)) || memcmp(magic, ImageCacheMagic, sizeof(magic)) != 0 || !read(&version, sizeof(version)) || version != ImageCacheVersion)
+	{
+		Log(LOG_WARNING) << "Ignoring invalid image cache " << filename;
+		return;
+	}
+	while (pos < data.size())
+	{
+		Uint32 pathSize;
+		Uint16 paletteSize;
+		ImageCacheEntry entry;
+		if (!read(&pathSize, sizeof(pathSize)) || data.size() - pos < pathSize)
+		{
+			break;
+		}
+		std::string path(&data[pos], pathSize);
+		pos += pathSize;
+		if (!read(&entry.size, sizeof(entry.size)) || !read(&entry.modified, sizeof(entry.modified)) ||
+			!read(&entry.width, sizeof(entry.width)) || !read(&entry.height, sizeof(entry.height)) ||
+			!read(&entry.transparent, sizeof(entry.transparent)) || !read(&paletteSize, sizeof(paletteSize)) || paletteSize > 256 ||
+			data.size() - pos < paletteSize * sizeof(SDL_Color) + (size_t)entry.width * entry.height)
+		{
+			break;
+		}
+		entry.palette.resize(paletteSize);
+		entry.pixels.resize(entry.width * entry.height);
+		if (!read(entry.palette.data(), paletteSize * sizeof(SDL_Color)) || !read(entry.pixels.data(), entry.pixels.size()))
+		{
+			break;
+		}
+		entry.used = false;
+		imageCache[path] = std::move(entry);
+	}
+	Log(LOG_VERBOSE) << "Image cache has " << imageCache.size() << " images";
+}
+
+/**
+ * Writes images decoded or reused by this run, if they differ from
+ * what the cache already holds, and stops using the cache.
+ * @param filename Filename of the cache.
+ */
+void Surface::saveImageCache(const std::string &filename)
+{
+	bool changed = imageCacheChanged;
+	for (std::map<std::string, ImageCacheEntry>::const_iterator i = imageCache.begin(); i != imageCache.end(); ++i)
+	{
+		changed = changed || !i->second.used;
+	}
+	if (changed)
+	{
+		std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+		file.write(ImageCacheMagic, sizeof(ImageCacheMagic));
+		file.write((const char*)&ImageCacheVersion, sizeof(ImageCacheVersion));
+		for (std::map<std::string, ImageCacheEntry>::const_iterator i = imageCache.begin(); i != imageCache.end(); ++i)
+		{
+			const ImageCacheEntry &entry = i->second;
+			if (!entry.used)
+			{
+				continue;
+			}
+			Uint32 pathSize = i->first.size();
+			Uint16 paletteSize = entry.palette.size();
+			file.write((const char*)&pathSize, sizeof(pathSize));
+			file.write(i->first.data(), pathSize);
+			file.write((const char*)&entry.size, sizeof(entry.size));
+			file.write((const char*)&entry.modified, sizeof(entry.modified));
+			file.write((const char*)&entry.width, sizeof(entry.width));
+			file.write((const char*)&entry.height, sizeof(entry.height));
+			file.write((const char*)&entry.transparent, sizeof(entry.transparent));
+			file.write((const char*)&paletteSize, sizeof(paletteSize));
+			file.write((const char*)entry.palette.data(), paletteSize * sizeof(SDL_Color));
+			file.write((const char*)entry.pixels.data(), entry.pixels.size());
+		}
+		if (!file)
+		{
+			Log(LOG_WARNING) << "Failed to save image cache " << filename;
+		}
+	}
+	imageCache.clear();
+	imageCacheActive = false;
+	imageCacheChanged = false;
+}
+
 /**
  * Loads the contents of an X-Com SPK image file into
  * the surface. SPK files are compressed with a custom
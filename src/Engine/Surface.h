@@ -61,6 +61,10 @@ public:
 	void loadBdy(const std::string &filename);
 	/// Loads a general image file.
 	void loadImage(const std::string &filename);
+	/// Starts reusing images decoded by previous run.
+	static void loadImageCache(const std::string &filename);
+	/// Saves images decoded by this run and stops using the cache.
+	static void saveImageCache(const std::string &filename);
 	/// Clears the surface's contents eith a specified colour.
 	void clear(Uint32 color = 0);
 	/// Offsets the surface's colors by a set amount.
@@ -100,9 +100,8 @@ void ConfirmCydoniaState::btnYesClick(Action *)
 		}
 	}
 	bgen.setCraft(_craft);
-	bgen.run();
 
-	_game->pushState(new BriefingState(_craft));
+	_game->pushState(new BriefingState(_craft, 0, new BattlescapeGenerator(bgen)));
 
 }
 
@@ -212,8 +212,7 @@ void ConfirmLandingState::btnYesClick(Action *)
 	{
 		throw Exception("No mission available!");
 	}
-	bgen.run();
-	_game->pushState(new BriefingState(_craft));
+	_game->pushState(new BriefingState(_craft, 0, new BattlescapeGenerator(bgen)));
 }
 
 /**
@@ -34,6 +34,7 @@
 #include "../Interface/Text.h"
 #include "../Interface/TextButton.h"
 #include "../Engine/Timer.h"
+#include "../Engine/Profiler.h"
 #include "../Savegame/GameTime.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/Base.h"
@@ -690,6 +691,7 @@ void GeoscapeState::timeAdvance()
  */
 void GeoscapeState::time5Seconds()
 {
+	Profiler::Scope scope("GeoscapeState::time5Seconds");
 	// Game over if there are no more bases.
 	if (_game->getSavedGame()->getBases()->empty())
 	{
@@ -1060,6 +1062,7 @@ struct SetRetaliationTarget: public std::unary_function<std::map<const Region *,
  */
 void GeoscapeState::time10Minutes()
 {
+	Profiler::Scope scope("GeoscapeState::time10Minutes");
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		// Fuel consumption for XCOM craft.
@@ -1210,6 +1213,7 @@ struct expireCrashedUfo: public std::unary_function<Ufo*, void>
  */
 void GeoscapeState::time30Minutes()
 {
+	Profiler::Scope scope("GeoscapeState::time30Minutes");
 	// Decrease mission countdowns
 	std::for_each(_game->getSavedGame()->getAlienMissions().begin(),
 			  _game->getSavedGame()->getAlienMissions().end(),
@@ -1394,6 +1398,7 @@ void GeoscapeState::time30Minutes()
  */
 void GeoscapeState::time1Hour()
 {
+	Profiler::Scope scope("GeoscapeState::time1Hour");
 	// Handle craft maintenance
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
@@ -1519,6 +1524,7 @@ void GenerateSupplyMission::operator()(const AlienBase *base) const
  */
 void GeoscapeState::time1Day()
 {
+	Profiler::Scope scope("GeoscapeState::time1Day");
 	SavedGame *saveGame = _game->getSavedGame();
 	Mod *mod = _game->getMod();
 	for (Base *base : *_game->getSavedGame()->getBases())
@@ -1741,6 +1747,7 @@ void GeoscapeState::time1Day()
  */
 void GeoscapeState::time1Month()
 {
+	Profiler::Scope scope("GeoscapeState::time1Month");
 	_game->getSavedGame()->addMonth();
 
 	// Determine alien mission for this month.
@@ -2229,9 +2236,8 @@ void GeoscapeState::handleBaseDefense(Base *base, Ufo *ufo)
 		bgen.setAlienRace(ufo->getAlienRace());
 		bgen.setWorldShade(shade);
 		bgen.setWorldTexture(_game->getMod()->getGlobe()->getTexture(texture));
-		bgen.run();
 		_pause = true;
-		_game->pushState(new BriefingState(0, base));
+		_game->pushState(new BriefingState(0, base, new BattlescapeGenerator(bgen)));
 	}
 	else
 	{
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfilerOverlay.h"
+#include <sstream>
+#include <iomanip>
+#include "../Engine/Timer.h"
+#include "../Engine/Language.h"
+#include "../Engine/Profiler.h"
+#include "Text.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a profiler overlay of the specified size.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param x X position in pixels.
+ * @param y Y position in pixels.
+ */
+ProfilerOverlay::ProfilerOverlay(int width, int height, int x, int y) : Surface(width, height, x, y)
+{
+	_visible = Profiler::isEnabled();
+
+	_timer = new Timer(500);
+	_timer->onTimer((SurfaceHandler)&ProfilerOverlay::update);
+	_timer->start();
+
+	_text = new Text(width, height, 0, 0);
+}
+
+/**
+ * Deletes profiler overlay content.
+ */
+ProfilerOverlay::~ProfilerOverlay()
+{
+	delete _text;
+	delete _timer;
+}
+
+/**
+ * Changes the fonts used by the overlay, only drawn once they are set.
+ * @param big Pointer to large-size font.
+ * @param small Pointer to small-size font.
+ * @param lang Pointer to current language.
+ */
+void ProfilerOverlay::initText(Font *big, Font *small, Language *lang)
+{
+	_text->initText(big, small, lang);
+	_redraw = true;
+}
+
+/**
+ * Replaces a certain amount of colors in the overlay palette.
+ * @param colors Pointer to the set of colors.
+ * @param firstcolor Offset of the first color to replace.
+ * @param ncolors Amount of colors to replace.
+ */
+void ProfilerOverlay::setPalette(SDL_Color *colors, int firstcolor, int ncolors)
+{
+	Surface::setPalette(colors, firstcolor, ncolors);
+	_text->setPalette(colors, firstcolor, ncolors);
+}
+
+/**
+ * Sets the text color of the overlay.
+ * @param color The color to set.
+ */
+void ProfilerOverlay::setColor(Uint8 color)
+{
+	_text->setColor(color);
+}
+
+/**
+ * Advances the refresh timer.
+ */
+void ProfilerOverlay::think()
+{
+	_timer->think(0, this);
+}
+
+/**
+ * Lists the longest sections of the last frame.
+ */
+void ProfilerOverlay::update()
+{
+	if (!_visible)
+	{
+		return;
+	}
+	std::wostringstream ss;
+	ss << std::fixed << std::setprecision(1);
+	ss << L"Frame " << Profiler::getFrameTime() << L" ms";
+	const std::vector<std::pair<const char*, double> > &breakdown = Profiler::getFrameBreakdown();
+	for (size_t i = 0; i < breakdown.size() && i < MAX_LINES; ++i)
+	{
+		ss << L"\n" << Language::utf8ToWstr(breakdown[i].first) << L" " << breakdown[i].second;
+	}
+	_text->setText(ss.str());
+	_redraw = true;
+}
+
+/**
+ * Draws the profiler overlay.
+ */
+void ProfilerOverlay::draw()
+{
+	Surface::draw();
+	_text->blit(this);
+}
+
+}
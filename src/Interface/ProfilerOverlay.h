@@ -0,0 +1,59 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../Engine/Surface.h"
+
+namespace OpenXcom
+{
+
+class Text;
+class Timer;
+class Font;
+class Language;
+
+/**
+ * Shows where the time of the last frame went,
+ * as recorded by the profiler.
+ */
+class ProfilerOverlay : public Surface
+{
+private:
+	static const int MAX_LINES = 8;
+	Text *_text;
+	Timer *_timer;
+public:
+	/// Creates a new profiler overlay.
+	ProfilerOverlay(int width, int height, int x, int y);
+	/// Cleans up the profiler overlay.
+	~ProfilerOverlay();
+	/// Initializes the overlay's text.
+	void initText(Font *big, Font *small, Language *lang);
+	/// Sets the overlay's palette.
+	void setPalette(SDL_Color *colors, int firstcolor = 0, int ncolors = 256);
+	/// Sets the overlay's color.
+	void setColor(Uint8 color);
+	/// Advances the refresh timer.
+	void think();
+	/// Updates the frame breakdown.
+	void update();
+	/// Draws the profiler overlay.
+	void draw();
+};
+
+}
@@ -59,13 +59,18 @@ TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(wid
  */
 TextList::~TextList()
 {
-	for (std::vector< std::vector<Text*> >::iterator u = _texts.begin(); u < _texts.end(); ++u)
+	hideRows();
+	for (std::vector< std::vector<Text*> >::iterator u = _pool.begin(); u < _pool.end(); ++u)
 	{
 		for (std::vector<Text*>::iterator v = (*u).begin(); v < (*u).end(); ++v)
 		{
 			delete *v;
 		}
 	}
+	for (std::vector<Text*>::iterator i = _measure.begin(); i < _measure.end(); ++i)
+	{
+		delete *i;
+	}
 	for (std::vector<ArrowButton*>::iterator i = _arrowLeft.begin(); i < _arrowLeft.end(); ++i)
 	{
 		delete *i;
@@ -151,7 +156,12 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
-	_texts[row][column]->setColor(color);
+	_texts[row].cells[column].color = color;
+	_texts[row].cells[column].color2 = color;
+	if (!_texts[row].texts.empty())
+	{
+		_texts[row].texts[column]->setColor(color);
+	}
 	_redraw = true;
 }
 
@@ -162,9 +172,9 @@ void TextList::setCellColor(size_t row, size_t column, Uint8 color)
  */
 void TextList::setRowColor(size_t row, Uint8 color)
 {
-	for (std::vector<Text*>::iterator i = _texts[row].begin(); i < _texts[row].end(); ++i)
+	for (size_t i = 0; i < _texts[row].cells.size(); ++i)
 	{
-		(*i)->setColor(color);
+		setCellColor(row, i, color);
 	}
 	_redraw = true;
 }
@@ -177,7 +187,7 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::wstring TextList::getCellText(size_t row, size_t column) const
 {
-	return _texts[row][column]->getText();
+	return _texts[row].cells[column].text;
 }
 
 /**
@@ -188,7 +198,26 @@ std::wstring TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::wstring &text)
 {
-	_texts[row][column]->setText(text);
+	TextListCell &cell = _texts[row].cells[column];
+	Text *txt = getMeasureText(column, cell.width, _texts[row].height);
+	if (cell.small)
+	{
+		txt->setSmall();
+	}
+	else
+	{
+		txt->setBig();
+	}
+	txt->setWordWrap(cell.wrap, cell.wrap);
+	txt->setText(text);
+	cell.text = txt->getText();
+	cell.small = (txt->getFont() != _big);
+	cell.textHeight = txt->getTextHeight();
+	cell.numLines = txt->getNumLines();
+	if (!_texts[row].texts.empty())
+	{
+		_texts[row].texts[column]->setText(text);
+	}
 	_redraw = true;
 }
 
@@ -199,7 +228,7 @@ void TextList::setCellText(size_t row, size_t column, const std::wstring &text)
  */
 int TextList::getColumnX(size_t column) const
 {
-	return getX() + _texts[0][column]->getX();
+	return getX() + _texts[0].cells[column].x;
 }
 
 /**
@@ -209,7 +238,7 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
-	return getY() + _texts[row][0]->getY();
+	return getY() + _texts[row].y;
 }
 
 /**
@@ -219,7 +248,7 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
-	return _texts[row].front()->getTextHeight();
+	return _texts[row].cells.front().textHeight;
 }
 
 /**
@@ -229,7 +258,7 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
-	return _texts[row].front()->getNumLines();
+	return _texts[row].cells.front().numLines;
 }
 
 /**
@@ -279,36 +308,35 @@ void TextList::addRow(int cols, ...)
 		ncols = 1;
 	}
 
-	std::vector<Text*> temp;
+	TextListRow temp;
 	// Positions are relative to list surface.
-	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
+	int rowX = 0, rows = 1, rowHeight = 0;
+	temp.y = 0;
 	if (!_texts.empty())
 	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		temp.y = _texts.back().y + _texts.back().height + _font->getSpacing();
 	}
 
 	for (int i = 0; i < ncols; ++i)
 	{
-		int width;
+		TextListCell cell;
 		// Place text
 		if (_flooding)
 		{
-			width = 340;
+			cell.width = 340;
 		}
 		else
 		{
-			width = _columns[i];
-		}
-		Text* txt = new Text(width, _font->getHeight(), _margin + rowX, rowY);
-		txt->setPalette(this->getPalette());
-		txt->initText(_big, _small, _lang);
-		txt->setColor(_color);
-		txt->setSecondaryColor(_color2);
-		if (_align[i])
-		{
-			txt->setAlign(_align[i]);
+			cell.width = _columns[i];
 		}
-		txt->setHighContrast(_contrast);
+		cell.x = _margin + rowX;
+		cell.color = _color;
+		cell.color2 = _color2;
+		cell.align = _align[i];
+		cell.wrap = false;
+
+		// Lay out the text now, it's only drawn once it's on screen
+		Text* txt = getMeasureText(i, cell.width, _font->getHeight());
 		if (_font == _big)
 		{
 			txt->setBig();
@@ -317,8 +345,7 @@ void TextList::addRow(int cols, ...)
 		{
 			txt->setSmall();
 		}
-		if (cols > 0)
-			txt->setText(va_arg(args, wchar_t*));
+		txt->setText(cols > 0 ? va_arg(args, wchar_t*) : L"");
 		// grab this before we enable word wrapping so we can use it to calculate
 		// the total row height below
 		int vmargin = _font->getHeight() - txt->getTextHeight();
@@ -326,6 +353,7 @@ void TextList::addRow(int cols, ...)
 		if (_wrap && txt->getTextWidth() > txt->getWidth())
 		{
 			txt->setWordWrap(true, true);
+			cell.wrap = true;
 			rows = std::max(rows, txt->getNumLines());
 		}
 		rowHeight = std::max(rowHeight, txt->getTextHeight() + vmargin);
@@ -351,7 +379,11 @@ void TextList::addRow(int cols, ...)
 			txt->setText(buf);
 		}
 
-		temp.push_back(txt);
+		cell.text = txt->getText();
+		cell.small = (txt->getFont() != _big);
+		cell.textHeight = txt->getTextHeight();
+		cell.numLines = txt->getNumLines();
+		temp.cells.push_back(cell);
 		if (_condensed)
 		{
 			rowX += txt->getTextWidth();
@@ -363,10 +395,7 @@ void TextList::addRow(int cols, ...)
 	}
 
 	// ensure all elements in this row are the same height
-	for (int i = 0; i < cols; ++i)
-	{
-		temp[i]->setHeight(rowHeight);
-	}
+	temp.height = rowHeight;
 
 	_texts.push_back(temp);
 	for (int i = 0; i < rows; ++i)
@@ -442,7 +471,14 @@ void TextList::setColumns(int cols, ...)
 void TextList::setPalette(SDL_Color *colors, int firstcolor, int ncolors)
 {
 	Surface::setPalette(colors, firstcolor, ncolors);
-	for (std::vector< std::vector<Text*> >::iterator u = _texts.begin(); u < _texts.end(); ++u)
+	for (std::vector<size_t>::iterator u = _shown.begin(); u < _shown.end(); ++u)
+	{
+		for (std::vector<Text*>::iterator v = _texts[*u].texts.begin(); v < _texts[*u].texts.end(); ++v)
+		{
+			(*v)->setPalette(colors, firstcolor, ncolors);
+		}
+	}
+	for (std::vector< std::vector<Text*> >::iterator u = _pool.begin(); u < _pool.end(); ++u)
 	{
 		for (std::vector<Text*>::iterator v = u->begin(); v < u->end(); ++v)
 		{
@@ -480,6 +516,14 @@ void TextList::initText(Font *big, Font *small, Language *lang)
 	_font = small;
 	_lang = lang;
 
+	for (std::vector<Text*>::iterator i = _measure.begin(); i < _measure.end(); ++i)
+	{
+		if (*i != 0)
+		{
+			(*i)->initText(_big, _small, _lang);
+		}
+	}
+
 	delete _selector;
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
 	_selector->setPalette(getPalette());
@@ -513,12 +557,9 @@ void TextList::setColor(Uint8 color)
 	_up->setColor(color);
 	_down->setColor(color);
 	_scrollbar->setColor(color);
-	for (std::vector< std::vector<Text*> >::iterator u = _texts.begin(); u < _texts.end(); ++u)
+	for (size_t row = 0; row < _texts.size(); ++row)
 	{
-		for (std::vector<Text*>::iterator v = u->begin(); v < u->end(); ++v)
-		{
-			(*v)->setColor(color);
-		}
+		setRowColor(row, color);
 	}
 }
 
@@ -568,9 +609,9 @@ void TextList::setWordWrap(bool wrap)
 void TextList::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	for (std::vector< std::vector<Text*> >::iterator u = _texts.begin(); u < _texts.end(); ++u)
+	for (std::vector<size_t>::iterator u = _shown.begin(); u < _shown.end(); ++u)
 	{
-		for (std::vector<Text*>::iterator v = u->begin(); v < u->end(); ++v)
+		for (std::vector<Text*>::iterator v = _texts[*u].texts.begin(); v < _texts[*u].texts.end(); ++v)
 		{
 			(*v)->setHighContrast(contrast);
 		}
@@ -812,14 +853,7 @@ void TextList::onRightArrowRelease(ActionHandler handler)
  */
 void TextList::clearList()
 {
-	for (std::vector< std::vector<Text*> >::iterator u = _texts.begin(); u < _texts.end(); ++u)
-	{
-		for (std::vector<Text*>::iterator v = u->begin(); v < u->end(); ++v)
-		{
-			delete (*v);
-		}
-		u->clear();
-	}
+	hideRows();
 	scrollUp(true, false);
 	_texts.clear();
 	_rows.clear();
@@ -911,6 +945,124 @@ void TextList::updateVisible()
 	updateArrows();
 }
 
+/**
+ * Gets the Text used to lay out the cells of a column,
+ * so rows can be measured without creating their own surfaces.
+ * @param column Column number.
+ * @param width Width of the cell in pixels.
+ * @param height Height of the cell in pixels.
+ * @return Pointer to the measuring Text.
+ */
+Text *TextList::getMeasureText(size_t column, int width, int height)
+{
+	if (column >= _measure.size())
+	{
+		_measure.resize(column + 1, 0);
+	}
+	Text *txt = _measure[column];
+	if (txt == 0)
+	{
+		txt = new Text(width, height);
+		txt->initText(_big, _small, _lang);
+		_measure[column] = txt;
+	}
+	else
+	{
+		if (txt->getWidth() != width)
+		{
+			txt->setWidth(width);
+		}
+		if (txt->getHeight() != height)
+		{
+			txt->setHeight(height);
+		}
+		txt->setWordWrap(false);
+	}
+	return txt;
+}
+
+/**
+ * Sets up Text objects for all the cells of a row,
+ * reusing the ones released by rows that went off screen.
+ * @param row Row number.
+ */
+void TextList::showRow(size_t row)
+{
+	TextListRow &r = _texts[row];
+	if (r.cells.size() > _pool.size())
+	{
+		_pool.resize(r.cells.size());
+	}
+	for (size_t i = 0; i < r.cells.size(); ++i)
+	{
+		const TextListCell &cell = r.cells[i];
+		Text *txt;
+		if (_pool[i].empty())
+		{
+			txt = new Text(cell.width, r.height, cell.x, r.y);
+			txt->setPalette(getPalette());
+		}
+		else
+		{
+			txt = _pool[i].back();
+			_pool[i].pop_back();
+			if (txt->getWidth() != cell.width)
+			{
+				txt->setWidth(cell.width);
+			}
+			if (txt->getHeight() != r.height)
+			{
+				txt->setHeight(r.height);
+			}
+			txt->setX(cell.x);
+			txt->setY(r.y);
+		}
+		txt->initText(_big, _small, _lang);
+		txt->setColor(cell.color);
+		txt->setSecondaryColor(cell.color2);
+		txt->setAlign(cell.align);
+		txt->setHighContrast(_contrast);
+		txt->setWordWrap(cell.wrap, cell.wrap);
+		if (cell.small)
+		{
+			txt->setSmall();
+		}
+		else
+		{
+			txt->setBig();
+		}
+		txt->setText(cell.text);
+		r.texts.push_back(txt);
+	}
+	_shown.push_back(row);
+}
+
+/**
+ * Gives the Text objects of a row back for reuse.
+ * @param row Row number.
+ */
+void TextList::hideRow(size_t row)
+{
+	TextListRow &r = _texts[row];
+	for (size_t i = 0; i < r.texts.size(); ++i)
+	{
+		_pool[i].push_back(r.texts[i]);
+	}
+	r.texts.clear();
+}
+
+/**
+ * Gives the Text objects of all the rows on screen back for reuse.
+ */
+void TextList::hideRows()
+{
+	for (std::vector<size_t>::iterator i = _shown.begin(); i < _shown.end(); ++i)
+	{
+		hideRow(*i);
+	}
+	_shown.clear();
+}
+
 /**
  * Changes whether the list can be scrolled.
  * @param scrolling True to allow scrolling, false otherwise.
@@ -935,6 +1087,25 @@ void TextList::draw()
 {
 	Surface::draw();
 	int y = 0;
+	size_t first = 0, last = 0;
+	if (!_rows.empty())
+	{
+		first = _rows[_scroll];
+		last = std::min(_texts.size(), first + _visibleRows);
+	}
+	// give back the Text objects of rows that went off screen
+	for (std::vector<size_t>::iterator i = _shown.begin(); i != _shown.end();)
+	{
+		if (*i < first || *i >= last)
+		{
+			hideRow(*i);
+			i = _shown.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
 	if (!_rows.empty())
 	{
 		// for wrapped items, offset the draw height above the visible surface
@@ -943,16 +1114,21 @@ void TextList::draw()
 		{
 			y -= _font->getHeight() + _font->getSpacing();
 		}
-		for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows; ++i)
+		for (size_t i = first; i < last; ++i)
 		{
-			for (std::vector<Text*>::iterator j = _texts[i].begin(); j < _texts[i].end(); ++j)
+			if (_texts[i].texts.empty())
+			{
+				showRow(i);
+			}
+			_texts[i].y = y;
+			for (std::vector<Text*>::iterator j = _texts[i].texts.begin(); j < _texts[i].texts.end(); ++j)
 			{
 				(*j)->setY(y);
 				(*j)->blit(this);
 			}
-			if (!_texts[i].empty())
+			if (!_texts[i].cells.empty())
 			{
-				y += _texts[i].front()->getHeight() + _font->getSpacing();
+				y += _texts[i].height + _font->getSpacing();
 			}
 			else
 			{
@@ -995,9 +1171,9 @@ void TextList::blit(Surface *surface)
 					_arrowRight[i]->blit(surface);
 				}
 
-				if (!_texts[i].empty())
+				if (!_texts[i].cells.empty())
 				{
-					y += _texts[i].front()->getHeight() + _font->getSpacing();
+					y += _texts[i].height + _font->getSpacing();
 				}
 				else
 				{
@@ -1154,9 +1330,9 @@ void TextList::mouseOver(Action *action, State *state)
 		_selRow = std::max(0, (int)(_scroll + (int)floor(action->getRelativeYMouse() / (rowHeight * action->getYScale()))));
 		if (_selRow < _rows.size())
 		{
-			Text *selText = _texts[_rows[_selRow]].front();
-			int y = getY() + selText->getY();
-			int actualHeight = selText->getHeight() + _font->getSpacing(); //current line height
+			const TextListRow &selRow = _texts[_rows[_selRow]];
+			int y = getY() + selRow.y;
+			int actualHeight = selRow.height + _font->getSpacing(); //current line height
 			if (y < getY() || y + actualHeight > getY() + getHeight())
 			{
 				actualHeight /= 2;
@@ -31,17 +31,45 @@ class ArrowButton;
 class ComboBox;
 class ScrollBar;
 
+/**
+ * Plain data of a single cell in a text list.
+ * Only turned into a Text while its row is on screen.
+ */
+struct TextListCell
+{
+	std::wstring text;
+	int x, width, textHeight, numLines;
+	Uint8 color, color2;
+	TextHAlign align;
+	bool small, wrap;
+};
+
+/**
+ * Plain data of a single row in a text list,
+ * plus the Text objects drawing it while it's on screen.
+ */
+struct TextListRow
+{
+	std::vector<TextListCell> cells;
+	std::vector<Text*> texts;
+	int y, height;
+};
+
 /**
  * List of Text's split into columns.
  * Contains a set of Text's that are automatically lined up by
  * rows and columns, like a big table, making it easy to manage
  * them together.
+ * Rows are stored as plain data and only the rows on screen
+ * get actual Text objects, reused as the list scrolls.
  */
 class TextList : public InteractiveSurface
 {
 private:
-	std::vector< std::vector<Text*> > _texts;
-	std::vector<size_t> _columns, _rows;
+	std::vector<TextListRow> _texts;
+	std::vector< std::vector<Text*> > _pool;
+	std::vector<Text*> _measure;
+	std::vector<size_t> _columns, _rows, _shown;
 	Font *_big, *_small, *_font;
 	Language *_lang;
 	size_t _scroll, _visibleRows, _selRow;
@@ -64,6 +92,14 @@ private:
 	void updateArrows();
 	/// Updates the visible rows.
 	void updateVisible();
+	/// Gets the Text used to lay out cells of a column.
+	Text *getMeasureText(size_t column, int width, int height);
+	/// Creates the Text objects for a row.
+	void showRow(size_t row);
+	/// Releases the Text objects of a row.
+	void hideRow(size_t row);
+	/// Releases the Text objects of all rows.
+	void hideRows();
 public:
 	/// Creates a text list with the specified size and position.
 	TextList(int width, int height, int x = 0, int y = 0);
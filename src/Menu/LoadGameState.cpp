@@ -151,7 +151,8 @@ void LoadGameState::think()
 	{
 		_game->popState();
 
-		// Load the game
+		// Load the game, after any save still written in background is done
+		_game->waitForSave();
 		SavedGame *s = new SavedGame();
 		try
 		{
@@ -533,11 +533,9 @@ void NewBattleState::btnOkClick(Action *)
 	bgen.setAlienItemlevel(_slrAlienTech->getValue());
 	bgame->setDepth(_slrDepth->getValue());
 
-	bgen.run();
-
 	_game->popState();
 	_game->popState();
-	_game->pushState(new BriefingState(_craft, base));
+	_game->pushState(new BriefingState(_craft, base, new BattlescapeGenerator(bgen)));
 	_craft = 0;
 }
 
@@ -18,6 +18,7 @@
  */
 #include "SaveGameState.h"
 #include <sstream>
+#include <vector>
 #include "../Engine/Logger.h"
 #include "../Engine/Game.h"
 #include "../Engine/Exception.h"
@@ -155,6 +156,37 @@ void SaveGameState::think()
 		}
 
 		// Save the game
+		if (_type != SAVE_IRONMAN_END)
+		{
+			// only conversion to YAML need the game, writing is done in background.
+			OptionsOrigin origin = _origin;
+			std::vector<SDL_Color> palette(_palette, _palette + 256);
+			Game *game = _game;
+			try
+			{
+				_game->saveInBackground(_game->getSavedGame()->createSnapshot(_game->getMod()), _filename,
+					[=](const std::string &error) mutable
+					{
+						if (!error.empty())
+						{
+							showError(game, origin, palette.data(), error);
+						}
+					}
+				);
+			}
+			catch (Exception &e)
+			{
+				Log(LOG_ERROR) << e.what();
+				showError(_game, _origin, _palette, e.what());
+			}
+			catch (YAML::Exception &e)
+			{
+				Log(LOG_ERROR) << e.what();
+				showError(_game, _origin, _palette, e.what());
+			}
+			return;
+		}
+
 		try
 		{
 			std::string backup = _filename + ".bak";
@@ -166,36 +198,40 @@ void SaveGameState::think()
 				throw Exception("Save backed up in " + backup);
 			}
 
-			if (_type == SAVE_IRONMAN_END)
-			{
-				Screen::updateScale(Options::geoscapeScale, Options::geoscapeScale, Options::baseXGeoscape, Options::baseYGeoscape, true);
-				_game->getScreen()->resetDisplay(false);
+			Screen::updateScale(Options::geoscapeScale, Options::geoscapeScale, Options::baseXGeoscape, Options::baseYGeoscape, true);
+			_game->getScreen()->resetDisplay(false);
 
-				_game->setState(new MainMenuState);
-				_game->setSavedGame(0);
-			}
+			_game->setState(new MainMenuState);
+			_game->setSavedGame(0);
 		}
 		catch (Exception &e)
 		{
 			Log(LOG_ERROR) << e.what();
-			std::wostringstream error;
-			error << tr("STR_SAVE_UNSUCCESSFUL") << L'\x02' << Language::fsToWstr(e.what());
-			if (_origin != OPT_BATTLESCAPE)
-				_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
-			else
-				_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+			showError(_game, _origin, _palette, e.what());
 		}
 		catch (YAML::Exception &e)
 		{
 			Log(LOG_ERROR) << e.what();
-			std::wostringstream error;
-			error << tr("STR_SAVE_UNSUCCESSFUL") << L'\x02' << Language::fsToWstr(e.what());
-			if (_origin != OPT_BATTLESCAPE)
-				_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
-			else
-				_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+			showError(_game, _origin, _palette, e.what());
 		}
 	}
 }
 
+/**
+ * Shows error message of failed save.
+ * @param game Pointer to the core game.
+ * @param origin Game section that originated this state.
+ * @param palette Palette of the state.
+ * @param message Error message.
+ */
+void SaveGameState::showError(Game *game, OptionsOrigin origin, SDL_Color *palette, const std::string &message)
+{
+	std::wostringstream error;
+	error << game->getLanguage()->getString("STR_SAVE_UNSUCCESSFUL") << L'\x02' << Language::fsToWstr(message);
+	if (origin != OPT_BATTLESCAPE)
+		game->pushState(new ErrorMessageState(error.str(), palette, game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
+	else
+		game->pushState(new ErrorMessageState(error.str(), palette, game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+}
+
 }
@@ -39,6 +39,8 @@ private:
 	Text *_txtStatus;
 	std::string _filename;
 	SaveType _type;
+	/// Shows error message of failed save.
+	static void showError(Game *game, OptionsOrigin origin, SDL_Color *palette, const std::string &message);
 public:
 	/// Creates the Save Game state.
 	SaveGameState(OptionsOrigin origin, const std::string &filename, SDL_Color *palette);
@@ -30,8 +30,10 @@
 #include "../Engine/Font.h"
 #include "../Engine/Timer.h"
 #include "../Engine/CrossPlatform.h"
+#include "../Mod/Mod.h"
 #include "../Interface/FpsCounter.h"
 #include "../Interface/Cursor.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Interface/Text.h"
 #include "MainMenuState.h"
 #include "CutsceneState.h"
@@ -134,6 +136,9 @@ void StartState::init()
 		_game->initAudio();
 	}
 
+	// Fonts of the old mod are deleted by the loading thread
+	_game->getProfilerOverlay()->initText(0, 0, 0);
+
 	// Load the game data in a separate thread
 	_thread = SDL_CreateThread(load, (void*)_game);
 	if (_thread == 0)
@@ -178,6 +183,7 @@ void StartState::think()
 		}
 		_game->getCursor()->setVisible(true);
 		_game->getFpsCounter()->setVisible(Options::fpsCounter);
+		_game->getProfilerOverlay()->initText(_game->getMod()->getFont("FONT_BIG"), _game->getMod()->getFont("FONT_SMALL"), _game->getLanguage());
 		break;
 	default:
 		break;
@@ -17,18 +17,40 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <sstream>
+#include <fstream>
 #include <algorithm>
 #include "MapBlock.h"
 #include "../Battlescape/Position.h"
 #include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Reads whole binary file from game data.
+ * @param filename Name of file in virtual file system.
+ * @param data Vector filled with file content.
+ */
+void readBlockFile(const std::string &filename, std::vector<unsigned char> &data)
+{
+	std::ifstream file(FileMap::getFilePath(filename).c_str(), std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		throw Exception(filename + " not found");
+	}
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+}
+
 /**
  * MapBlock construction.
  */
-MapBlock::MapBlock(const std::string &name):_name(name), _size_x(10), _size_y(10), _size_z(4)
+MapBlock::MapBlock(const std::string &name):_name(name), _size_x(10), _size_y(10), _size_z(4), _mapFileLoaded(false), _routeFileLoaded(false)
 {
 	_groups.push_back(0);
 }
@@ -164,4 +186,34 @@ const std::map<std::string, std::pair<int, int> > *MapBlock::getItemsFuseTimers(
 	return &_itemsFuseTimer;
 }
 
+/**
+ * Gets content of the MAP file of this block. File is read only once,
+ * every other placement of this block use the copy in memory.
+ * @return Bytes of MAPS/<name>.MAP.
+ */
+const std::vector<unsigned char> &MapBlock::getMapFile()
+{
+	if (!_mapFileLoaded)
+	{
+		readBlockFile("MAPS/" + _name + ".MAP", _mapFile);
+		_mapFileLoaded = true;
+	}
+	return _mapFile;
+}
+
+/**
+ * Gets content of the RMP file of this block. File is read only once,
+ * every other placement of this block use the copy in memory.
+ * @return Bytes of ROUTES/<name>.RMP.
+ */
+const std::vector<unsigned char> &MapBlock::getRouteFile()
+{
+	if (!_routeFileLoaded)
+	{
+		readBlockFile("ROUTES/" + _name + ".RMP", _routeFile);
+		_routeFileLoaded = true;
+	}
+	return _routeFile;
+}
+
 }
@@ -42,6 +42,8 @@ private:
 	std::vector<int> _groups, _revealedFloors;
 	std::map<std::string, std::vector<Position> > _items;
 	std::map<std::string, std::pair<int, int> > _itemsFuseTimer;
+	std::vector<unsigned char> _mapFile, _routeFile;
+	bool _mapFileLoaded, _routeFileLoaded;
 public:
 	MapBlock(const std::string &name);
 	~MapBlock();
@@ -65,6 +67,10 @@ public:
 	const std::map<std::string, std::vector<Position> > *getItems() const;
 	/// Gets the fuse timer for any items that belong in this map block.
 	const std::map<std::string, std::pair<int, int> > *getItemsFuseTimers() const;
+	/// Gets content of the MAP file, read on first use.
+	const std::vector<unsigned char> &getMapFile();
+	/// Gets content of the RMP file, read on first use.
+	const std::vector<unsigned char> &getRouteFile();
 
 };
 
@@ -20,6 +20,7 @@
 #include "ModScript.h"
 #include <algorithm>
 #include <sstream>
+#include <fstream>
 #include <climits>
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/FileMap.h"
@@ -49,6 +50,7 @@
 #include "../fmath.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "../Battlescape/Pathfinding.h"
 #include "RuleCountry.h"
 #include "RuleRegion.h"
@@ -264,9 +266,10 @@ public:
 		_modNames.push_back(s);
 	}
 	/// Set current mod id.
-	void setMod(int i)
+	void setMod(const std::string& s, int i)
 	{
 		updateConst("RuleList.current", (int)i);
+		setCurrentModName(s);
 		_modCurr = i;
 	}
 };
@@ -880,6 +883,7 @@ int Mod::getSoundOffset(int sound, const std::string& set) const
  */
 void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::string> > > &mods)
 {
+	Profiler::Scope scope("Mod::loadAll");
 	ModScript parser{ _scriptGlobal, this };
 
 	Log(LOG_INFO) << "Loading rulesets...";
@@ -902,9 +906,10 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 	}
 	for (size_t i = 0; mods.size() > i; ++i)
 	{
-		_scriptGlobal->setMod((int)modOffsets[i]);
+		_scriptGlobal->setMod(mods[i].first, (int)modOffsets[i]);
 		try
 		{
+			Profiler::Scope scope("Mod::loadMod", mods[i].first);
 			loadMod(mods[i].second, modOffsets[i], parser);
 		}
 		catch (Exception &e)
@@ -964,7 +969,15 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 	}
 
 	sortLists();
+	if (Options::spriteCache)
+	{
+		Surface::loadImageCache(Options::getUserFolder() + "sprites.cache");
+	}
 	loadExtraResources();
+	if (Options::spriteCache)
+	{
+		Surface::saveImageCache(Options::getUserFolder() + "sprites.cache");
+	}
 	modResources();
 }
 
@@ -2913,6 +2926,7 @@ namespace
  */
 void Mod::loadVanillaResources()
 {
+	Profiler::Scope scope("Mod::loadVanillaResources");
 	// Load palettes
 	const char *pal[] = { "PAL_GEOSCAPE", "PAL_BASESCAPE", "PAL_GRAPHS", "PAL_UFOPAEDIA", "PAL_BATTLEPEDIA" };
 	for (size_t i = 0; i < sizeof(pal) / sizeof(pal[0]); ++i)
@@ -3121,11 +3135,179 @@ void Mod::loadVanillaResources()
 	loadBattlescapeResources(); // TODO load this at battlescape start, unload at battlescape end?
 }
 
+namespace
+{
+
+/**
+ * Finds palette colors closest to given RGB values.
+ * The RGB cube is split into 32x32x32 cells and for each cell that gets used
+ * we remember only colors that can be closest to some point inside it,
+ * so lookups give same results as a search of the whole palette.
+ */
+class NearestColorFinder
+{
+	static const int CellShift = 3;
+	static const int CellCount = 256 >> CellShift;
+
+	const SDL_Color *_colors;
+	std::vector<std::vector<Uint8> > _cells;
+
+	/**
+	 * Fills list of candidate colors for one cell.
+	 * @param cell List to fill.
+	 * @param r Red cell index.
+	 * @param g Green cell index.
+	 * @param b Blue cell index.
+	 */
+	void buildCell(std::vector<Uint8> &cell, int r, int g, int b) const
+	{
+		const int low[3] = { r << CellShift, g << CellShift, b << CellShift };
+		const int high[3] = { low[0] + (1 << CellShift) - 1, low[1] + (1 << CellShift) - 1, low[2] + (1 << CellShift) - 1 };
+		int minDistance[256];
+		int bound = INT_MAX;
+		for (int i = 0; i < 256; ++i)
+		{
+			const int c[3] = { _colors[i].r, _colors[i].g, _colors[i].b };
+			int closestPoint = 0, furthestPoint = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				closestPoint += Sqr(c[k] < low[k] ? low[k] - c[k] : c[k] > high[k] ? c[k] - high[k] : 0);
+				furthestPoint += Sqr(std::max(std::abs(c[k] - low[k]), std::abs(c[k] - high[k])));
+			}
+			minDistance[i] = closestPoint;
+			bound = std::min(bound, furthestPoint);
+		}
+		// any color further than worst case of best color can't win, ties keep palette order
+		for (int i = 0; i < 256; ++i)
+		{
+			if (minDistance[i] <= bound)
+			{
+				cell.push_back(i);
+			}
+		}
+	}
+
+public:
+	/// Creates finder for 256 colors palette.
+	NearestColorFinder(const SDL_Color *colors) : _colors(colors), _cells(CellCount * CellCount * CellCount)
+	{
+
+	}
+
+	/**
+	 * Gets palette index of color closest to given one, lowest index wins ties.
+	 * @param r Red value.
+	 * @param g Green value.
+	 * @param b Blue value.
+	 * @return Palette index.
+	 */
+	Uint8 find(int r, int g, int b)
+	{
+		const int cr = r >> CellShift, cg = g >> CellShift, cb = b >> CellShift;
+		std::vector<Uint8> &cell = _cells[(cr * CellCount + cg) * CellCount + cb];
+		if (cell.empty())
+		{
+			buildCell(cell, cr, cg, cb);
+		}
+		Uint8 closest = 0;
+		int lowestDifference = INT_MAX;
+		for (std::vector<Uint8>::const_iterator i = cell.begin(); i != cell.end(); ++i)
+		{
+			int currentDifference = Sqr(r - _colors[*i].r) + Sqr(g - _colors[*i].g) + Sqr(b - _colors[*i].b);
+			if (currentDifference < lowestDifference)
+			{
+				closest = *i;
+				lowestDifference = currentDifference;
+			}
+		}
+		return closest;
+	}
+};
+
+}
+
+/**
+ * Gets hash of everything a transparency lookup table depends on.
+ * @param pal Palette of the table.
+ * @param tints Transparency colors from rulesets.
+ * @return FNV-1a hash.
+ */
+static Uint64 hashTransparencyLUT(const Palette *pal, const std::vector<SDL_Color> &tints)
+{
+	Uint64 hash = 14695981039346656037ULL;
+	const auto add = [&](Uint8 v)
+	{
+		hash = (hash ^ v) * 1099511628211ULL;
+	};
+	for (int i = 0; i < 256; ++i)
+	{
+		add(pal->getColors(i)->r);
+		add(pal->getColors(i)->g);
+		add(pal->getColors(i)->b);
+	}
+	for (std::vector<SDL_Color>::const_iterator tint = tints.begin(); tint != tints.end(); ++tint)
+	{
+		add(tint->r);
+		add(tint->g);
+		add(tint->b);
+		add(tint->unused);
+	}
+	return hash;
+}
+
+/**
+ * Loads transparency lookup tables saved by previous run.
+ * @param filename Cache file.
+ * @param size Expected size of each table.
+ * @param cache Map of tables by hash to fill.
+ */
+static void loadTransparencyCache(const std::string &filename, size_t size, std::map<Uint64, std::vector<Uint8> > &cache)
+{
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	Uint64 hash;
+	Uint32 entrySize;
+	while (file.read((char*)&hash, sizeof(hash)) && file.read((char*)&entrySize, sizeof(entrySize)))
+	{
+		if (entrySize != size)
+		{
+			break;
+		}
+		std::vector<Uint8> lut(size);
+		if (!file.read((char*)lut.data(), size))
+		{
+			break;
+		}
+		cache[hash].swap(lut);
+	}
+}
+
+/**
+ * Saves transparency lookup tables for next run.
+ * @param filename Cache file.
+ * @param cache Map of tables by hash.
+ */
+static void saveTransparencyCache(const std::string &filename, const std::map<Uint64, std::vector<Uint8> > &cache)
+{
+	std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+	for (std::map<Uint64, std::vector<Uint8> >::const_iterator i = cache.begin(); i != cache.end(); ++i)
+	{
+		Uint32 entrySize = i->second.size();
+		file.write((const char*)&i->first, sizeof(i->first));
+		file.write((const char*)&entrySize, sizeof(entrySize));
+		file.write((const char*)i->second.data(), entrySize);
+	}
+	if (!file)
+	{
+		Log(LOG_WARNING) << "Failed to save transparency cache " << filename;
+	}
+}
+
 /**
  * Loads the resources required by the Battlescape.
  */
 void Mod::loadBattlescapeResources()
 {
+	Profiler::Scope scope("Mod::loadBattlescapeResources");
 	// Load Battlescape ICONS
 	_sets["SPICONS.DAT"] = new SurfaceSet(32, 24);
 	_sets["SPICONS.DAT"]->loadDat(FileMap::getFilePath("UFOGRAPH/SPICONS.DAT"));
@@ -3201,6 +3383,17 @@ void Mod::loadBattlescapeResources()
 	{ 2, 9, 24, 255 },
 	{ 2, 0, 24, 255 } };
 
+	// transparency tables only depend on palette and tints, reuse the ones from previous run
+	const std::string lutCacheFile = Options::getUserFolder() + "transparency.lut";
+	size_t lutSize = 0;
+	for (std::vector<SDL_Color>::const_iterator tint = _transparencies.begin(); tint != _transparencies.end(); ++tint)
+	{
+		lutSize += tint->unused ? 4 * 256 : 0;
+	}
+	std::map<Uint64, std::vector<Uint8> > lutCache, lutUsed;
+	loadTransparencyCache(lutCacheFile, lutSize, lutCache);
+	bool lutCacheChanged = false;
+
 	std::set<std::string> ufographContents = FileMap::getVFolderContents("UFOGRAPH");
 	for (size_t i = 0; i < sizeof(lbms) / sizeof(lbms[0]); ++i)
 	{
@@ -3220,9 +3413,24 @@ void Mod::loadBattlescapeResources()
 		SDL_Color *colors = tempSurface->getPalette();
 		colors[255] = backPal[i];
 		_palettes[pals[i]]->setColors(colors, 256);
-		createTransparencyLUT(_palettes[pals[i]]);
+		Uint64 lutHash = hashTransparencyLUT(_palettes[pals[i]], _transparencies);
+		std::map<Uint64, std::vector<Uint8> >::const_iterator lut = lutCache.find(lutHash);
+		if (lut != lutCache.end())
+		{
+			_transparencyLUTs.push_back(lut->second);
+		}
+		else
+		{
+			createTransparencyLUT(_palettes[pals[i]]);
+			lutCacheChanged = true;
+		}
+		lutUsed[lutHash] = _transparencyLUTs.back();
 		delete tempSurface;
 	}
+	if (lutCacheChanged || lutUsed.size() != lutCache.size())
+	{
+		saveTransparencyCache(lutCacheFile, lutUsed);
+	}
 
 	std::string spks[] = { "TAC01.SCR",
 		"DETBORD.PCK",
@@ -3417,6 +3625,7 @@ void Mod::loadBattlescapeResources()
  */
 void Mod::loadExtraResources()
 {
+	Profiler::Scope scope("Mod::loadExtraResources");
 	// Load fonts
 	YAML::Node doc = YAML::LoadFile(FileMap::getFilePath("Language/" + _fontName));
 	Log(LOG_INFO) << "Loading fonts... " << _fontName;
@@ -3687,6 +3896,7 @@ void Mod::loadExtraResources()
  */
 void Mod::modResources()
 {
+	Profiler::Scope scope("Mod::modResources");
 	// bigger geoscape background
 	int newWidth = 320 - 64, newHeight = 200;
 	Surface *newGeo = new Surface(newWidth * 3, newHeight * 3);
@@ -3875,15 +4085,16 @@ Music *Mod::loadMusic(MusicFormat fmt, const std::string &file, int track, float
  * Preamble:
  * this is the most horrible function i've ever written, and it makes me sad.
  * this is, however, a necessary evil, in order to save massive amounts of time in the draw function.
- * when used with the default TFTD mod, this function loops 4,194,304 times
- * (4 palettes, 4 tints, 4 levels of opacity, 256 colors, 256 comparisons per)
- * each additional tint in the rulesets will result in over a million iterations more.
+ * when used with the default TFTD mod, this function looks up 16,384 colors per palette
+ * (4 tints, 4 levels of opacity, 256 colors), NearestColorFinder keeps the comparisons per color low
+ * and finished tables are cached in the user folder.
  * @param pal the palette to base the lookup table on.
  */
 void Mod::createTransparencyLUT(Palette *pal)
 {
 	SDL_Color desiredColor;
 	std::vector<Uint8> lookUpTable;
+	NearestColorFinder finder(pal->getColors());
 	// start with the color sets
 	for (std::vector<SDL_Color>::const_iterator tint = _transparencies.begin(); tint != _transparencies.end(); ++tint)
 	{
@@ -3901,22 +4112,8 @@ void Mod::createTransparencyLUT(Palette *pal)
 				desiredColor.g = std::min(255, (int)(pal->getColors(currentColor)->g) + (tint->g * opacity));
 				desiredColor.b = std::min(255, (int)(pal->getColors(currentColor)->b) + (tint->b * opacity));
 
-				Uint8 closest = 0;
-				int lowestDifference = INT_MAX;
-				// now compare each color in the palette to find the closest match to our desired one
-				for (int comparator = 0; comparator < 256; ++comparator)
-				{
-					int currentDifference = Sqr(desiredColor.r - pal->getColors(comparator)->r) +
-						Sqr(desiredColor.g - pal->getColors(comparator)->g) +
-						Sqr(desiredColor.b - pal->getColors(comparator)->b);
-
-					if (currentDifference < lowestDifference)
-					{
-						closest = comparator;
-						lowestDifference = currentDifference;
-					}
-				}
-				lookUpTable.push_back(closest);
+				// now find the closest match to our desired one in the palette
+				lookUpTable.push_back(finder.find(desiredColor.r, desiredColor.g, desiredColor.b));
 			}
 		}
 	}
@@ -93,6 +93,36 @@ BattleItem::~BattleItem()
 {
 }
 
+/**
+ * Allocates memory for new item from shared pool.
+ * @param size Size of object.
+ * @return Pointer to memory.
+ */
+void *BattleItem::operator new(size_t size)
+{
+	return getPool().allocate(size);
+}
+
+/**
+ * Returns memory of deleted item to shared pool.
+ * @param p Pointer to memory.
+ * @param size Size of object.
+ */
+void BattleItem::operator delete(void *p, size_t size)
+{
+	getPool().deallocate(p, size);
+}
+
+/**
+ * Gets shared pool of items, created on first use.
+ * @return Pool.
+ */
+ObjectPool<BattleItem> &BattleItem::getPool()
+{
+	static ObjectPool<BattleItem> pool;
+	return pool;
+}
+
 /**
  * Loads the item from a YAML file.
  * @param node YAML node.
@@ -20,6 +20,7 @@
 #include <yaml-cpp/yaml.h>
 #include "../Mod/RuleItem.h"
 #include "../Engine/Script.h"
+#include "../Engine/ObjectPool.h"
 
 namespace OpenXcom
 {
@@ -77,6 +78,12 @@ public:
 	BattleItem(RuleItem *rules, int *id);
 	/// Cleans up the item.
 	~BattleItem();
+	/// Allocates memory from shared pool of items.
+	static void *operator new(size_t size);
+	/// Returns memory to shared pool of items.
+	static void operator delete(void *p, size_t size);
+	/// Gets shared pool of items.
+	static ObjectPool<BattleItem> &getPool();
 	/// Loads the item from YAML.
 	void load(const YAML::Node& node, const ScriptGlobal *shared);
 	/// Saves the item to YAML.
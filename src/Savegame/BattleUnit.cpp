@@ -1603,23 +1603,52 @@ void BattleUnit::clearVisibleUnits()
 /**
  * Add this unit to the list of visible tiles.
  * @param tile that we're now able to see.
+ * @param tileIndex index of tile in map.
  * @return true if a new tile.
  */
-bool BattleUnit::addToVisibleTiles(Tile *tile)
+bool BattleUnit::addToVisibleTiles(Tile *tile, int tileIndex)
 {
 	//Only add once, otherwise we're going to mess up the visibility value and make trouble for the AI (if sneaky).
-	if (_visibleTilesLookup.insert(tile).second)
+	if (markVisibleTile(tile, tileIndex))
 	{
 		tile->setVisible(1);
-		_visibleTiles.push_back(tile);
 		return true;
 	}
 	return false;
 }
 
-bool BattleUnit::hasVisibleTile(Tile *tile) const
+/**
+ * Add tile to the list of visible tiles, but leave its visibility value unchanged.
+ * Caller is responsible for updating the tile later, this allows tracing FOV of different units at same time.
+ * @param tile that we're now able to see.
+ * @param tileIndex index of tile in map.
+ * @return true if a new tile.
+ */
+bool BattleUnit::markVisibleTile(Tile *tile, int tileIndex)
+{
+	if (hasVisibleTile(tileIndex))
+	{
+		return false;
+	}
+	const size_t word = tileIndex / 32;
+	if (word >= _visibleTilesLookup.size())
+	{
+		_visibleTilesLookup.resize(word + 1, 0);
+	}
+	_visibleTilesLookup[word] |= 1u << (tileIndex % 32);
+	_visibleTiles.push_back(tile);
+	return true;
+}
+
+/**
+ * Has this unit marked this tile as within its view?
+ * @param tileIndex index of tile in map.
+ * @return true if tile is visible.
+ */
+bool BattleUnit::hasVisibleTile(int tileIndex) const
 {
-	return _visibleTilesLookup.find(tile) != _visibleTilesLookup.end(); //find?
+	const size_t word = tileIndex / 32;
+	return word < _visibleTilesLookup.size() && (_visibleTilesLookup[word] & (1u << (tileIndex % 32)));
 }
 
 /**
@@ -1640,7 +1669,8 @@ void BattleUnit::clearVisibleTiles()
 	{
 		(*j)->setVisible(-1);
 	}
-	_visibleTilesLookup.clear();
+	// bitset is kept allocated, next FOV calculation will fill it again.
+	std::fill(_visibleTilesLookup.begin(), _visibleTilesLookup.end(), 0);
 	_visibleTiles.clear();
 }
 
@@ -23,6 +23,7 @@
 #include "SavedGame.h"
 #include "Tile.h"
 #include "Node.h"
+#include "../Battlescape/Particle.h"
 #include "../Mod/MapDataSet.h"
 #include "../Mod/MCDPatch.h"
 #include "../Battlescape/Pathfinding.h"
@@ -51,7 +52,7 @@ namespace OpenXcom
  */
 SavedBattleGame::SavedBattleGame(Mod *rule) :
 	_battleState(0), _rule(rule), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0),
-	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0), _side(FACTION_PLAYER), _turn(1), _animFrame(0),
+	_lastSelectedUnit(0), _nodeCandidatesCount(0), _pathfinding(0), _tileEngine(0), _globalShade(0), _side(FACTION_PLAYER), _turn(1), _animFrame(0),
 	_debugMode(false), _aborted(false), _itemId(0), _objectiveType(-1), _objectivesDestroyed(0), _objectivesNeeded(0), _unitsFalling(false),
 	_cheating(false), _tuReserved(BA_NONE), _kneelReserved(false), _depth(0), _ambience(-1), _ambientVolume(0.5),
 	_turnLimit(0), _cheatTurn(20), _chronoTrigger(FORCE_LOSE), _beforeGame(true)
@@ -103,6 +104,11 @@ SavedBattleGame::~SavedBattleGame()
 
 	delete _pathfinding;
 	delete _tileEngine;
+
+	// battle is over, release pooled memory if nothing else uses it.
+	_tiles.clear();
+	BattleItem::getPool().trim();
+	Particle::getPool().trim();
 }
 
 /**
@@ -521,6 +527,11 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	}
 
 	_nodes.clear();
+	for (int i = 0; i < 4; ++i)
+	{
+		_nodeCandidates[i].clear();
+	}
+	_nodeCandidatesCount = 0;
 
 	if (resetTerrain)
 	{
@@ -1455,19 +1466,13 @@ Node *SavedBattleGame::getSpawnNode(int nodeRank, BattleUnit *unit)
 {
 	int highestPriority = -1;
 	std::vector<Node*> compliantNodes;
+	const std::vector<Node*> &candidates = getNodeCandidates(unit);
 
-	for (std::vector<Node*>::iterator i = getNodes()->begin(); i != getNodes()->end(); ++i)
+	for (std::vector<Node*>::const_iterator i = candidates.begin(); i != candidates.end(); ++i)
 	{
-		if ((*i)->isDummy())
-		{
-			continue;
-		}
 		if ((*i)->getRank() == nodeRank								// ranks must match
-			&& (!((*i)->getType() & Node::TYPE_SMALL)
-				|| unit->getArmor()->getSize() == 1)				// the small unit bit is not set or the unit is small
-			&& (!((*i)->getType() & Node::TYPE_FLYING)
-				|| unit->getMovementType() == MT_FLY)				// the flying unit bit is not set or the unit can fly
 			&& (*i)->getPriority() > 0								// priority 0 is no spawnplace
+			&& (*i)->getPriority() >= highestPriority				// lower priority than already found is never picked
 			&& setUnitPosition(unit, (*i)->getPosition(), true))	// check if not already occupied
 		{
 			if ((*i)->getPriority() > highestPriority)
@@ -1475,10 +1480,7 @@ Node *SavedBattleGame::getSpawnNode(int nodeRank, BattleUnit *unit)
 				highestPriority = (*i)->getPriority();
 				compliantNodes.clear(); // drop the last nodes, as we found a higher priority now
 			}
-			if ((*i)->getPriority() == highestPriority)
-			{
-				compliantNodes.push_back((*i));
-			}
+			compliantNodes.push_back((*i));
 		}
 	}
 
@@ -1512,24 +1514,25 @@ Node *SavedBattleGame::getPatrolNode(bool scout, BattleUnit *unit, Node *fromNod
 	}
 
 	// scouts roam all over while all others shuffle around to adjacent nodes at most:
-	const int end = scout ? getNodes()->size() : fromNode->getNodeLinks()->size();
+	const std::vector<Node*> &candidates = getNodeCandidates(unit);
+	const int end = scout ? candidates.size() : fromNode->getNodeLinks()->size();
 
 	for (int i = 0; i < end; ++i)
 	{
 		if (!scout && fromNode->getNodeLinks()->at(i) < 1) continue;
 
-		Node *n = getNodes()->at(scout ? i : fromNode->getNodeLinks()->at(i));
+		Node *n = scout ? candidates[i] : getNodes()->at(fromNode->getNodeLinks()->at(i));
 		if ( !n->isDummy()																				// don't consider dummy nodes.
 			&& (n->getFlags() > 0 || n->getRank() > 0 || scout)											// for non-scouts we find a node with a desirability above 0
 			&& (!(n->getType() & Node::TYPE_SMALL) || unit->getArmor()->getSize() == 1)					// the small unit bit is not set or the unit is small
 			&& (!(n->getType() & Node::TYPE_FLYING) || unit->getMovementType() == MT_FLY)	// the flying unit bit is not set or the unit can fly
 			&& !n->isAllocated()																		// check if not allocated
 			&& !(n->getType() & Node::TYPE_DANGEROUS)													// don't go there if an alien got shot there; stupid behavior like that
-			&& setUnitPosition(unit, n->getPosition(), true)											// check if not already occupied
+			&& (!scout || n != fromNode)																// scouts push forward
+			&& n->getPosition().x > 0 && n->getPosition().y > 0
 			&& getTile(n->getPosition()) && !getTile(n->getPosition())->getFire()						// you are not a firefighter; do not patrol into fire
 			&& (unit->getFaction() != FACTION_HOSTILE || !getTile(n->getPosition())->getDangerous())	// aliens don't run into a grenade blast
-			&& (!scout || n != fromNode)																// scouts push forward
-			&& n->getPosition().x > 0 && n->getPosition().y > 0)
+			&& setUnitPosition(unit, n->getPosition(), true))											// check if not already occupied
 		{
 			if (!preferred
 				|| (unit->getRankInt() >=0 &&
@@ -1569,6 +1572,43 @@ Node *SavedBattleGame::getPatrolNode(bool scout, BattleUnit *unit, Node *fromNod
 	}
 }
 
+/**
+ * Gets the nodes that units of the same size and movement type can use,
+ * skipping dummies and nodes flagged for small or flying units only.
+ * Lists are rebuilt when nodes are added and dropped by initMap.
+ * @param unit Pointer to the unit.
+ * @return Nodes in map order.
+ */
+const std::vector<Node*> &SavedBattleGame::getNodeCandidates(const BattleUnit *unit)
+{
+	if (_nodeCandidatesCount != _nodes.size())
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			_nodeCandidates[i].clear();
+		}
+		for (std::vector<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+		{
+			if ((*i)->isDummy())
+			{
+				continue;
+			}
+			const int type = (*i)->getType();
+			for (int j = 0; j < 4; ++j)
+			{
+				const bool small = (j & 1) == 0, flying = (j & 2) != 0;
+				if ((!(type & Node::TYPE_SMALL) || small) && (!(type & Node::TYPE_FLYING) || flying))
+				{
+					_nodeCandidates[j].push_back(*i);
+				}
+			}
+		}
+		_nodeCandidatesCount = _nodes.size();
+	}
+	const int j = (unit->getArmor()->getSize() == 1 ? 0 : 1) | (unit->getMovementType() == MT_FLY ? 2 : 0);
+	return _nodeCandidates[j];
+}
+
 /**
  * Carries out new turn preparations such as fire and smoke spreading.
  */
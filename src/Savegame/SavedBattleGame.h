@@ -61,6 +61,8 @@ private:
 	std::vector<Tile> _tiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
+	std::vector<Node*> _nodeCandidates[4];
+	size_t _nodeCandidatesCount;
 	std::vector<BattleUnit*> _units;
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
@@ -90,6 +92,8 @@ private:
 	ChronoTrigger _chronoTrigger;
 	bool _beforeGame;
 	ScriptValues<SavedBattleGame> _scriptValues;
+	/// Gets nodes that units of given size and movement type can use.
+	const std::vector<Node*> &getNodeCandidates(const BattleUnit *unit);
 	/// Selects a soldier.
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
 
@@ -601,17 +601,21 @@ void SavedGame::load(const std::string &filename, Mod *mod)
  */
 void SavedGame::save(const std::string &filename, Mod *mod) const
 {
-	std::string s = Options::getMasterUserFolder() + filename;
-	std::ofstream sav(s.c_str());
-	if (!sav)
-	{
-		throw Exception("Failed to save " + filename);
-	}
+	writeSnapshot(createSnapshot(mod), filename);
+}
 
-	YAML::Emitter out;
+/**
+ * Converts a saved game's contents to YAML documents.
+ * This is the part of saving that need to see the game, writing them can be done later.
+ * @param mod Mod of the game.
+ * @return YAML documents of the game.
+ */
+SavedGameSnapshot SavedGame::createSnapshot(Mod *mod) const
+{
+	SavedGameSnapshot snapshot;
 
 	// Saves the brief game info used in the saves list
-	YAML::Node brief;
+	YAML::Node &brief = snapshot.brief;
 	brief["name"] = Language::wstrToUtf8(_name);
 	brief["version"] = OPENXCOM_VERSION_SHORT;
 	std::string git_sha = OPENXCOM_VERSION_GIT;
@@ -637,10 +641,8 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	brief["mods"] = modsList;
 	if (_ironman)
 		brief["ironman"] = _ironman;
-	out << brief;
 	// Saves the full game data to the save
-	out << YAML::BeginDoc;
-	YAML::Node node;
+	YAML::Node &node = snapshot.game;
 	node["difficulty"] = (int)_difficulty;
 	node["end"] = (int)_end;
 	node["monthsPassed"] = _monthsPassed;
@@ -717,7 +719,28 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	{
 		node["battleGame"] = _battleGame->save();
 	}
-	out << node;
+	return snapshot;
+}
+
+/**
+ * Writes YAML documents of a saved game to a file.
+ * Uses only the snapshot, so it is safe to call from another thread.
+ * @param snapshot YAML documents of the game.
+ * @param filename YAML filename.
+ */
+void SavedGame::writeSnapshot(const SavedGameSnapshot &snapshot, const std::string &filename)
+{
+	std::string s = Options::getMasterUserFolder() + filename;
+	std::ofstream sav(s.c_str());
+	if (!sav)
+	{
+		throw Exception("Failed to save " + filename);
+	}
+
+	YAML::Emitter out;
+	out << snapshot.brief;
+	out << YAML::BeginDoc;
+	out << snapshot.game;
 	sav << out.c_str();
 	sav.close();
 }
@@ -22,6 +22,7 @@
 #include <string>
 #include <time.h>
 #include <stdint.h>
+#include <yaml-cpp/yaml.h>
 #include "GameTime.h"
 #include "../Mod/RuleAlienMission.h"
 #include "../Savegame/Craft.h"
@@ -82,6 +83,16 @@ struct SaveInfo
 	bool reserved;
 };
 
+/**
+ * Game data converted to YAML, ready to be written to disk.
+ * Does not reference the game anymore, so it can be written by another thread.
+ */
+struct SavedGameSnapshot
+{
+	YAML::Node brief;
+	YAML::Node game;
+};
+
 struct PromotionInfo
 {
 	int totalCommanders;
@@ -146,6 +157,10 @@ public:
 	void load(const std::string &filename, Mod *mod);
 	/// Saves a saved game to YAML.
 	void save(const std::string &filename, Mod *mod) const;
+	/// Converts a saved game to YAML.
+	SavedGameSnapshot createSnapshot(Mod *mod) const;
+	/// Writes converted saved game to file.
+	static void writeSnapshot(const SavedGameSnapshot &snapshot, const std::string &filename);
 	/// Gets the game name.
 	std::wstring getName() const;
 	/// Sets the game name.